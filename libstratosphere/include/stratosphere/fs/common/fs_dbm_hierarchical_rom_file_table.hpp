@@ -40,10 +40,8 @@ namespace ams::fs {
             static constexpr Position FileIdToPosition(RomFileId id) {
                 return static_cast<Position>(id);
             }
-        private:
-            static constexpr inline Position InvalidPosition = ~Position();
+
             static constexpr inline Position RootPosition = 0;
-            static constexpr inline size_t ReservedDirectoryCount = 1;
 
             static constexpr RomDirectoryId PositionToDirectoryId(Position pos) {
                 return static_cast<RomDirectoryId>(pos);
@@ -52,6 +50,9 @@ namespace ams::fs {
             static constexpr Position DirectoryIdToPosition(RomDirectoryId id) {
                 return static_cast<Position>(id);
             }
+        private:
+            static constexpr inline Position InvalidPosition = ~Position();
+            static constexpr inline size_t ReservedDirectoryCount = 1;
 
             static_assert(std::is_same<RomDirectoryId, RomFileId>::value);
 
@@ -170,6 +171,9 @@ namespace ams::fs {
             Result OpenFile(FileInfo *out, const RomPathChar *path);
             Result OpenFile(FileInfo *out, RomFileId id);
 
+            /* Checks whether path, in the form "/dir/.../name" without redundant separators, is the full path of the file with the given id. */
+            Result IsFilePath(bool *out, RomFileId id, const RomPathChar *path, size_t path_length);
+
             Result FindOpen(FindPosition *out, const RomPathChar *path);
             Result FindOpen(FindPosition *out, RomDirectoryId id);
 
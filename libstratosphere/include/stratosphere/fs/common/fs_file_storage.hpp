@@ -66,6 +66,8 @@ namespace ams::fs {
                 m_base_file   = m_unique_file.get();
             }
         public:
+            /* NOTE: ReadAsync is left to IStorage's synchronous adapter. fsa::IFile has no asynchronous read to build on, so file-backed */
+            /* reads get their concurrency from the threads of a fssystem::StorageCompletionQueue instead. */
             virtual Result Read(s64 offset, void *buffer, size_t size) override;
             virtual Result Write(s64 offset, const void *buffer, size_t size) override;
             virtual Result Flush() override;
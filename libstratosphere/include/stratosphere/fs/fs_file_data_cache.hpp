@@ -0,0 +1,28 @@
+/*
+ * Copyright (c) Atmosphère-NX
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms and conditions of the GNU General Public License,
+ * version 2, as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+#include <stratosphere/fs/fs_common.hpp>
+
+namespace ams::fs {
+
+    /* NOTE: The buffer size is the cache's memory budget. Caches must not be disabled while reads are in progress. */
+    Result EnableGlobalFileDataCache(void *buffer, size_t size);
+    void DisableGlobalFileDataCache();
+
+    Result EnableIndividualFileDataCache(const char *mount_name, void *buffer, size_t size);
+    void DisableIndividualFileDataCache(const char *mount_name);
+
+}
@@ -20,6 +20,14 @@
 
 namespace ams::fs {
 
+    /* Receives the result of an asynchronous storage operation. */
+    class IStorageCompletion {
+        public:
+            virtual ~IStorageCompletion() { /* ... */ }
+
+            virtual void OnCompleted(Result result) = 0;
+    };
+
     class IStorage {
         public:
             virtual ~IStorage() { /* ... */ }
@@ -39,6 +47,19 @@ namespace ams::fs {
             virtual Result OperateRange(OperationId op_id, s64 offset, s64 size) {
                 return this->OperateRange(nullptr, 0, op_id, offset, size, nullptr, 0);
             }
+
+            /* Starts a read, and calls completion->OnCompleted() once it finishes. The completion may be called on any thread, */
+            /* including on the calling thread before this returns. Buffers must remain valid until the completion is called. */
+            /* By default, the operation is simply performed synchronously. */
+            virtual void ReadAsync(s64 offset, void *buffer, size_t size, IStorageCompletion *completion) {
+                AMS_ASSERT(completion != nullptr);
+                completion->OnCompleted(this->Read(offset, buffer, size));
+            }
+
+            virtual void OperateRangeAsync(void *dst, size_t dst_size, OperationId op_id, s64 offset, s64 size, const void *src, size_t src_size, IStorageCompletion *completion) {
+                AMS_ASSERT(completion != nullptr);
+                completion->OnCompleted(this->OperateRange(dst, dst_size, op_id, offset, size, src, src_size));
+            }
         public:
             static inline bool CheckAccessRange(s64 offset, s64 size, s64 total_size) {
                 return offset >= 0 &&
@@ -96,6 +117,14 @@ namespace ams::fs {
                 return m_storage->OperateRange(dst, dst_size, op_id, offset, size, src, src_size);
             }
 
+            virtual void ReadAsync(s64 offset, void *buffer, size_t size, IStorageCompletion *completion) override {
+                return m_storage->ReadAsync(offset, buffer, size, completion);
+            }
+
+            virtual void OperateRangeAsync(void *dst, size_t dst_size, OperationId op_id, s64 offset, s64 size, const void *src, size_t src_size, IStorageCompletion *completion) override {
+                return m_storage->OperateRangeAsync(dst, dst_size, op_id, offset, size, src, src_size, completion);
+            }
+
             virtual Result Write(s64 offset, const void *buffer, size_t size) override {
                 /* TODO: Better result? Is it possible to get a more specific one? */
                 AMS_UNUSED(offset, buffer, size);
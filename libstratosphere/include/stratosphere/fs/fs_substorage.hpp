@@ -139,6 +139,46 @@ namespace ams::fs {
             }
 
             using IStorage::OperateRange;
+
+            virtual void ReadAsync(s64 offset, void *buffer, size_t size, IStorageCompletion *completion) override {
+                AMS_ASSERT(completion != nullptr);
+
+                /* Validate arguments, completing immediately if we have nothing to forward. */
+                Result result = ResultSuccess();
+                if (!this->IsValid()) {
+                    result = fs::ResultNotInitialized();
+                } else if (size == 0) {
+                    result = ResultSuccess();
+                } else if (buffer == nullptr) {
+                    result = fs::ResultNullptrArgument();
+                } else if (!IStorage::CheckAccessRange(offset, size, m_size)) {
+                    result = fs::ResultOutOfRange();
+                } else {
+                    /* Forward to our base storage, which completes the request for us. */
+                    return m_base_storage->ReadAsync(m_offset + offset, buffer, size, completion);
+                }
+
+                return completion->OnCompleted(result);
+            }
+
+            virtual void OperateRangeAsync(void *dst, size_t dst_size, OperationId op_id, s64 offset, s64 size, const void *src, size_t src_size, IStorageCompletion *completion) override {
+                AMS_ASSERT(completion != nullptr);
+
+                /* Validate arguments, completing immediately if we have nothing to forward. */
+                Result result = ResultSuccess();
+                if (!this->IsValid()) {
+                    result = fs::ResultNotInitialized();
+                } else if (size == 0) {
+                    result = ResultSuccess();
+                } else if (!IStorage::CheckOffsetAndSize(offset, size)) {
+                    result = fs::ResultOutOfRange();
+                } else {
+                    /* Forward to our base storage, which completes the request for us. */
+                    return m_base_storage->OperateRangeAsync(dst, dst_size, op_id, m_offset + offset, size, src, src_size, completion);
+                }
+
+                return completion->OnCompleted(result);
+            }
     };
 
 }
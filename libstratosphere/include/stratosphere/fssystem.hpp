@@ -22,6 +22,8 @@
 #include <stratosphere/fssystem/fssystem_partition_file_system.hpp>
 #include <stratosphere/fssystem/fssystem_partition_file_system_meta.hpp>
 #include <stratosphere/fssystem/fssystem_thread_priority_changer.hpp>
+#include <stratosphere/fssystem/fssystem_thread_pool.hpp>
+#include <stratosphere/fssystem/fssystem_storage_completion_queue.hpp>
 #include <stratosphere/fssystem/fssystem_aes_ctr_storage.hpp>
 #include <stratosphere/fssystem/fssystem_aes_xts_storage.hpp>
 #include <stratosphere/fssystem/fssystem_subdirectory_filesystem.hpp>
@@ -40,9 +42,11 @@
 #include <stratosphere/fssystem/fssystem_aes_ctr_counter_extended_storage.hpp>
 #include <stratosphere/fssystem/buffers/fssystem_buffer_manager_utils.hpp>
 #include <stratosphere/fssystem/buffers/fssystem_file_system_buffer_manager.hpp>
+#include <stratosphere/fssystem/buffers/fssystem_sharded_file_system_buffer_manager.hpp>
 #include <stratosphere/fssystem/fssystem_pooled_buffer.hpp>
 #include <stratosphere/fssystem/fssystem_alignment_matching_storage_impl.hpp>
 #include <stratosphere/fssystem/fssystem_alignment_matching_storage.hpp>
+#include <stratosphere/fssystem/save/fssystem_cache_replacement_policy.hpp>
 #include <stratosphere/fssystem/save/fssystem_buffered_storage.hpp>
 #include <stratosphere/fssystem/save/fssystem_hierarchical_integrity_verification_storage.hpp>
 #include <stratosphere/fssystem/fssystem_integrity_romfs_storage.hpp>
@@ -268,7 +268,16 @@ namespace ams::fssystem {
                 m_buddy_heap.Finalize();
                 m_cache_handle_table.Finalize();
             }
+
+            /* Allocates from free memory only, without evicting any registered cache. */
+            const std::pair<uintptr_t, size_t> AllocateBufferWithoutEviction(size_t size);
+
+            size_t GetBufferSizeMax() const {
+                return m_buddy_heap.GetBytesFromOrder(m_buddy_heap.GetOrderMax() - 1);
+            }
         private:
+            std::pair<uintptr_t, size_t> AllocateBufferFromHeap(s32 order, size_t size);
+
             virtual const std::pair<uintptr_t, size_t> AllocateBufferImpl(size_t size, const BufferAttribute &attr) override;
 
             virtual void DeallocateBufferImpl(uintptr_t address, size_t size) override;
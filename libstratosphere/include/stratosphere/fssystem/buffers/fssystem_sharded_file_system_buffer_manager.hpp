@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) Atmosphère-NX
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms and conditions of the GNU General Public License,
+ * version 2, as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+#include <vapours.hpp>
+#include <stratosphere/fssystem/buffers/fssystem_i_buffer_manager.hpp>
+#include <stratosphere/fssystem/buffers/fssystem_file_system_buffer_manager.hpp>
+
+namespace ams::fssystem {
+
+    /* Splits part of the buffer manager heap into independently locked shards, so that threads working on different */
+    /* storages don't all serialize on a single buddy heap/cache table mutex. The rest of the heap stays in one */
+    /* global manager, which serves requests too large for a shard and absorbs overflow from the shards. */
+    class ShardedFileSystemBufferManager : public IBufferManager {
+        NON_COPYABLE(ShardedFileSystemBufferManager);
+        NON_MOVEABLE(ShardedFileSystemBufferManager);
+        public:
+            static constexpr s32 ShardCountMax = 8;
+        private:
+            static constexpr s32 GlobalIndex = ShardCountMax;
+        private:
+            FileSystemBufferManager m_shards[ShardCountMax];
+            FileSystemBufferManager m_global;
+            s32 m_shard_count;
+            uintptr_t m_address;
+            size_t m_shard_size;
+            size_t m_shard_buffer_size_max;
+        public:
+            ShardedFileSystemBufferManager() : m_shard_count(0), m_address(0), m_shard_size(0), m_shard_buffer_size_max(0) { /* ... */ }
+
+            virtual ~ShardedFileSystemBufferManager() { /* ... */ }
+
+            Result Initialize(s32 shard_count, s32 max_cache_count, uintptr_t address, size_t buffer_size, size_t block_size, size_t shard_size);
+
+            s32 GetShardCount() const {
+                return m_shard_count;
+            }
+        private:
+            FileSystemBufferManager &GetManager(s32 index) {
+                return index == GlobalIndex ? m_global : m_shards[index];
+            }
+
+            s32 GetHomeShardIndex() const;
+            s32 GetShardIndexFromAddress(uintptr_t address) const;
+        protected:
+            virtual const std::pair<uintptr_t, size_t> AllocateBufferImpl(size_t size, const BufferAttribute &attr) override;
+
+            virtual void DeallocateBufferImpl(uintptr_t address, size_t size) override;
+
+            virtual CacheHandle RegisterCacheImpl(uintptr_t address, size_t size, const BufferAttribute &attr) override;
+
+            virtual const std::pair<uintptr_t, size_t> AcquireCacheImpl(CacheHandle handle) override;
+
+            virtual size_t GetTotalSizeImpl() const override;
+
+            virtual size_t GetFreeSizeImpl() const override;
+
+            virtual size_t GetTotalAllocatableSizeImpl() const override;
+
+            virtual size_t GetPeakFreeSizeImpl() const override;
+
+            virtual size_t GetPeakTotalAllocatableSizeImpl() const override;
+
+            virtual size_t GetRetriedCountImpl() const override;
+
+            virtual void ClearPeakImpl() override;
+    };
+
+}
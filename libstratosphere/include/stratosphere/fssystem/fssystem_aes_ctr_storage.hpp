@@ -27,6 +27,8 @@ namespace ams::fssystem {
             static constexpr size_t BlockSize = crypto::Aes128CtrEncryptor::BlockSize;
             static constexpr size_t KeySize   = crypto::Aes128CtrEncryptor::KeySize;
             static constexpr size_t IvSize    = crypto::Aes128CtrEncryptor::IvSize;
+        private:
+            class DecryptionCompletion;
         private:
             IStorage * const m_base_storage;
             char m_key[KeySize];
@@ -45,6 +47,8 @@ namespace ams::fssystem {
             virtual Result GetSize(s64 *out) override;
 
             virtual Result OperateRange(void *dst, size_t dst_size, fs::OperationId op_id, s64 offset, s64 size, const void *src, size_t src_size) override;
+
+            virtual void ReadAsync(s64 offset, void *buffer, size_t size, fs::IStorageCompletion *completion) override;
     };
 
 }
@@ -156,6 +156,11 @@ namespace ams::fssystem {
                 R_TRY(this->GetSize(std::addressof(bs_size)));
                 R_UNLESS(fs::IStorage::CheckAccessRange(offset, size, bs_size), fs::ResultOutOfRange());
 
+                /* If the access is already aligned, we can read directly into the caller's buffer. */
+                if (AlignmentMatchingStorageImpl::IsAlignedAccess(offset, buffer, size, m_data_align, BufferAlign)) {
+                    return m_base_storage->Read(offset, buffer, size);
+                }
+
                 /* Allocate a pooled buffer. */
                 PooledBuffer pooled_buffer;
                 pooled_buffer.AllocateParticularlyLarge(m_data_align, m_data_align);
@@ -174,6 +179,11 @@ namespace ams::fssystem {
                 R_TRY(this->GetSize(std::addressof(bs_size)));
                 R_UNLESS(fs::IStorage::CheckAccessRange(offset, size, bs_size), fs::ResultOutOfRange());
 
+                /* If the access is already aligned, we can write directly from the caller's buffer. */
+                if (AlignmentMatchingStorageImpl::IsAlignedAccess(offset, buffer, size, m_data_align, BufferAlign)) {
+                    return m_base_storage->Write(offset, buffer, size);
+                }
+
                 /* Allocate a pooled buffer. */
                 PooledBuffer pooled_buffer;
                 pooled_buffer.AllocateParticularlyLarge(m_data_align, m_data_align);
@@ -259,6 +269,11 @@ namespace ams::fssystem {
                 R_TRY(this->GetSize(std::addressof(bs_size)));
                 R_UNLESS(fs::IStorage::CheckAccessRange(offset, size, bs_size), fs::ResultOutOfRange());
 
+                /* If the access is already aligned, we can write directly from the caller's buffer. */
+                if (AlignmentMatchingStorageImpl::IsAlignedAccess(offset, buffer, size, m_data_align, BufferAlign)) {
+                    return m_base_storage->Write(offset, buffer, size);
+                }
+
                 /* Allocate a pooled buffer. */
                 PooledBuffer pooled_buffer(m_data_align, m_data_align);
                 return AlignmentMatchingStorageImpl::Write(m_base_storage, pooled_buffer.GetBuffer(), pooled_buffer.GetSize(), m_data_align, BufferAlign, offset, static_cast<const char *>(buffer), size);
@@ -21,6 +21,11 @@ namespace ams::fssystem {
 
     class AlignmentMatchingStorageImpl {
         public:
+            static ALWAYS_INLINE bool IsAlignedAccess(s64 offset, const void *buffer, size_t size, size_t data_alignment, size_t buffer_alignment) {
+                /* An access which is aligned on every axis can be forwarded to the base storage without a work buffer. */
+                return util::IsAligned(offset, data_alignment) && util::IsAligned(size, data_alignment) && util::IsAligned(reinterpret_cast<uintptr_t>(buffer), buffer_alignment);
+            }
+
             static Result Read(fs::IStorage *base_storage, char *work_buf, size_t work_buf_size, size_t data_alignment, size_t buffer_alignment, s64 offset, char *buffer, size_t size);
             static Result Write(fs::IStorage *base_storage, char *work_buf, size_t work_buf_size, size_t data_alignment, size_t buffer_alignment, s64 offset, const char *buffer, size_t size);
     };
@@ -15,6 +15,7 @@
  */
 #pragma once
 #include <vapours.hpp>
+#include <stratosphere/os.hpp>
 #include <stratosphere/fs/fs_substorage.hpp>
 
 namespace ams::fssystem {
@@ -28,6 +29,8 @@ namespace ams::fssystem {
 
             static constexpr size_t NodeSizeMin = 1_KB;
             static constexpr size_t NodeSizeMax = 512_KB;
+
+            static constexpr s32 NodeCacheCount = 2;
         public:
             class Visitor;
 
@@ -149,6 +152,13 @@ namespace ams::fssystem {
                         return m_allocator;
                     }
             };
+
+            struct NodeCacheEntry {
+                s64 key;
+                void *buffer;
+                u64 last_used;
+            };
+            static_assert(util::is_pod<NodeCacheEntry>::value);
         private:
             static constexpr s32 GetEntryCount(size_t node_size, size_t entry_size) {
                 return static_cast<s32>((node_size - sizeof(NodeHeader)) / entry_size);
@@ -215,8 +225,13 @@ namespace ams::fssystem {
             s32 m_entry_set_count;
             s64 m_start_offset;
             s64 m_end_offset;
+            mutable NodeCacheEntry m_node_cache[NodeCacheCount];
+            mutable u64 m_node_cache_use_count;
+            mutable os::SdkMutex m_node_cache_mutex;
         public:
-            BucketTree() : m_node_storage(), m_entry_storage(), m_node_l1(), m_node_size(), m_entry_size(), m_entry_count(), m_offset_count(), m_entry_set_count(), m_start_offset(), m_end_offset() { /* ... */ }
+            BucketTree() : m_node_storage(), m_entry_storage(), m_node_l1(), m_node_size(), m_entry_size(), m_entry_count(), m_offset_count(), m_entry_set_count(), m_start_offset(), m_end_offset(), m_node_cache(), m_node_cache_use_count(), m_node_cache_mutex() {
+                this->InvalidateNodeCache();
+            }
             ~BucketTree() { this->Finalize(); }
 
             Result Initialize(IAllocator *allocator, fs::SubStorage node_storage, fs::SubStorage entry_storage, size_t node_size, size_t entry_size, s32 entry_count);
@@ -262,6 +277,14 @@ namespace ams::fssystem {
             s64 GetEntrySetIndex(s32 node_index, s32 offset_index) const {
                 return (m_offset_count - m_node_l1->count) + (m_offset_count * node_index) + offset_index;
             }
+
+            Result ReadNode(void *dst, s32 node_index) const;
+            Result ReadEntrySet(void *dst, s32 entry_set_index) const;
+            Result ReadEntrySetPartially(void *dst, s32 entry_set_index, s64 offset, size_t size) const;
+            Result ReadNodeWithCache(void *dst, fs::SubStorage &storage, s64 offset, s64 cache_key) const;
+
+            void InvalidateNodeCache() const;
+            void FinalizeNodeCache();
     };
 
     class BucketTree::Visitor {
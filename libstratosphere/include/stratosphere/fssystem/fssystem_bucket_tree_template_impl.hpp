@@ -50,8 +50,7 @@ namespace ams::fssystem {
         /* Read the node. */
         if (m_node_size <= pool.GetSize()) {
             buffer = pool.GetBuffer();
-            const auto ofs = param.entry_set.index * static_cast<s64>(m_node_size);
-            R_TRY(m_entry_storage.Read(ofs, buffer, m_node_size));
+            R_TRY(this->ReadEntrySet(buffer, param.entry_set.index));
         }
 
         /* Calculate extents. */
@@ -126,7 +125,8 @@ namespace ams::fssystem {
                 AMS_ASSERT(readable_size <= static_cast<s64>(param.size));
 
                 /* Update whether we've merged. */
-                merged |= merge_size > 0;
+                /* NOTE: Physically contiguous entries are worth a single read even with no fragments between them. */
+                merged |= merge_size > 0 || entry_index != param.entry_index;
                 merge_size = 0;
             }
 
@@ -129,6 +129,7 @@ namespace ams::fssystem {
             Result GetEntryList(Entry *out_entries, s32 *out_entry_count, s32 entry_count, s64 offset, s64 size);
 
             virtual Result Read(s64 offset, void *buffer, size_t size) override;
+            virtual void ReadAsync(s64 offset, void *buffer, size_t size, fs::IStorageCompletion *completion) override;
             virtual Result OperateRange(void *dst, size_t dst_size, fs::OperationId op_id, s64 offset, s64 size, const void *src, size_t src_size) override;
 
             virtual Result GetSize(s64 *out) override {
@@ -83,8 +83,10 @@ namespace ams::fssystem {
             size_t m_meta_data_size;
             MemoryResource *m_allocator;
             char *m_buffer;
+            size_t m_buffer_size;
+            s32 *m_name_index;
         public:
-            PartitionFileSystemMetaCore() : m_initialized(false), m_allocator(nullptr), m_buffer(nullptr) { /* ... */ }
+            PartitionFileSystemMetaCore() : m_initialized(false), m_allocator(nullptr), m_buffer(nullptr), m_buffer_size(0), m_name_index(nullptr) { /* ... */ }
             ~PartitionFileSystemMetaCore();
 
             Result Initialize(fs::IStorage *storage, MemoryResource *allocator);
@@ -99,7 +101,13 @@ namespace ams::fssystem {
         public:
             static Result QueryMetaDataSize(size_t *out_size, fs::IStorage *storage);
         protected:
+            static Result QueryMetaDataSize(size_t *out_size, s32 *out_entry_count, fs::IStorage *storage);
+
+            bool AllocateBuffer(s32 entry_count);
             void DeallocateBuffer();
+            void BuildNameIndex();
+        private:
+            s32 GetEntryIndexLinear(const char *name) const;
     };
 
     using PartitionFileSystemMeta = PartitionFileSystemMetaCore<impl::PartitionFileSystemFormat>;
@@ -99,6 +99,10 @@ namespace ams::fssystem {
     size_t GetPooledBufferReduceAllocationCount();
     size_t GetPooledBufferFreeSizePeak();
 
+    size_t GetPooledBufferMagazineHitCount();
+    size_t GetPooledBufferMagazineFallbackCount();
+    size_t GetPooledBufferMagazineCachedSizePeak();
+
     void ClearPooledBufferPeak();
 
     void RegisterAdditionalDeviceAddress(uintptr_t address, size_t size);
@@ -19,6 +19,7 @@
 #include <stratosphere/fs/impl/fs_newable.hpp>
 #include <stratosphere/fs/common/fs_dbm_hierarchical_rom_file_table.hpp>
 #include <stratosphere/fs/fs_istorage.hpp>
+#include <stratosphere/fs/fs_memory_management.hpp>
 
 namespace ams::fssystem {
 
@@ -26,6 +27,16 @@ namespace ams::fssystem {
         NON_COPYABLE(RomFsFileSystem);
         public:
             using RomFileTable = fs::HierarchicalRomFileTable;
+        private:
+            struct PathIndexEntry {
+                u64 hash;
+                fs::RomFileId id;
+                RomFileTable::FileInfo info;
+            };
+            static_assert(util::is_pod<PathIndexEntry>::value);
+
+            static constexpr size_t PathIndexSizeMax = 256_KB;
+            static constexpr size_t PathIndexCountMax = util::FloorPowerOfTwo(PathIndexSizeMax / sizeof(PathIndexEntry));
         private:
             RomFileTable m_rom_file_table;
             fs::IStorage *m_base_storage;
@@ -35,8 +46,13 @@ namespace ams::fssystem {
             std::unique_ptr<fs::IStorage> m_file_bucket_storage;
             std::unique_ptr<fs::IStorage> m_file_entry_storage;
             s64 m_entry_size;
+            std::unique_ptr<PathIndexEntry[], fs::impl::Deleter> m_path_index;
+            size_t m_path_index_count;
         private:
             Result GetFileInfo(RomFileTable::FileInfo *out, const char *path);
+
+            void BuildPathIndex(const fs::RomFileSystemInformation &header);
+            bool FindInPathIndex(RomFileTable::FileInfo *out, const char *path);
         public:
             static Result GetRequiredWorkingMemorySize(size_t *out, fs::IStorage *storage);
         public:
@@ -93,6 +93,7 @@ namespace ams::fssystem {
             }
 
             virtual Result Read(s64 offset, void *buffer, size_t size) override;
+            virtual void ReadAsync(s64 offset, void *buffer, size_t size, fs::IStorageCompletion *completion) override;
         private:
             void SetZeroStorage() {
                 return this->SetStorage(1, std::addressof(m_zero_storage), 0, std::numeric_limits<s64>::max());
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) Atmosphère-NX
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms and conditions of the GNU General Public License,
+ * version 2, as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+#include <vapours.hpp>
+#include <stratosphere/os.hpp>
+#include <stratosphere/fs/fs_istorage.hpp>
+#include <stratosphere/fssystem/fssystem_thread_pool.hpp>
+
+namespace ams::fssystem {
+
+    /* Runs asynchronous storage requests on threads of its own, and collects them as they complete. */
+    class StorageCompletionQueue {
+        NON_COPYABLE(StorageCompletionQueue);
+        NON_MOVEABLE(StorageCompletionQueue);
+        public:
+            /* Requests run whole storage stacks (decryption, ipc to the host file system) on our threads. */
+            static constexpr size_t ThreadStackSizeMin = 32_KB;
+
+            /* Caller-owned storage for a submitted request. */
+            class Request : public fs::IStorageCompletion, public util::IntrusiveListBaseNode<Request> {
+                NON_COPYABLE(Request);
+                NON_MOVEABLE(Request);
+                friend class StorageCompletionQueue;
+                private:
+                    enum class Operation {
+                        Read,
+                        OperateRange,
+                    };
+                private:
+                    ThreadPool::AsyncTask m_task;
+                    StorageCompletionQueue *m_queue;
+                    fs::IStorage *m_storage;
+                    Operation m_operation;
+                    fs::OperationId m_operation_id;
+                    s64 m_offset;
+                    s64 m_size;
+                    void *m_buffer;
+                    size_t m_buffer_size;
+                    const void *m_src;
+                    size_t m_src_size;
+                    void *m_user_data;
+                    Result m_result;
+                    bool m_is_pending;
+                public:
+                    Request() : m_task(), m_queue(nullptr), m_storage(nullptr), m_operation(Operation::Read), m_operation_id(), m_offset(), m_size(), m_buffer(nullptr), m_buffer_size(), m_src(nullptr), m_src_size(), m_user_data(nullptr), m_result(ResultSuccess()), m_is_pending(false) { /* ... */ }
+
+                    Result GetResult() const {
+                        AMS_ASSERT(!m_is_pending);
+                        return m_result;
+                    }
+
+                    void *GetUserData() const { return m_user_data; }
+                private:
+                    virtual void OnCompleted(Result result) override;
+            };
+        private:
+            using RequestList = util::IntrusiveListBaseTraits<Request>::ListType;
+        private:
+            ThreadPool m_thread_pool;
+            RequestList m_completed_requests;
+            s32 m_outstanding_count;
+            mutable os::SdkMutex m_mutex;
+            os::SdkConditionVariable m_cv;
+        public:
+            StorageCompletionQueue() : m_thread_pool(), m_completed_requests(), m_outstanding_count(0), m_mutex(), m_cv() { /* ... */ }
+
+            ~StorageCompletionQueue() {
+                this->Finalize();
+            }
+
+            /* Starts thread_count threads to run requests on, each with at least ThreadStackSizeMin of the stack buffer. */
+            /* Until this is called (or if it fails), requests run on the submitting thread. */
+            Result Initialize(s32 thread_count, void *stack_buffer, size_t stack_buffer_size, s32 priority);
+            void Finalize();
+
+            /* Submits a request. The request, storage and buffers must remain valid until the request is returned by Wait or TryWait. */
+            void SubmitRead(Request *request, fs::IStorage *storage, s64 offset, void *buffer, size_t size, void *user_data);
+            void SubmitOperateRange(Request *request, fs::IStorage *storage, void *dst, size_t dst_size, fs::OperationId op_id, s64 offset, s64 size, const void *src, size_t src_size, void *user_data);
+
+            /* Returns a completed request, blocking until one completes. Returns nullptr if no requests are outstanding. */
+            Request *Wait();
+
+            /* Returns a completed request, or nullptr if none has completed yet. */
+            Request *TryWait();
+
+            s32 GetOutstandingCount() const {
+                std::scoped_lock lk(m_mutex);
+                return m_outstanding_count;
+            }
+        private:
+            void Submit(Request *request);
+            void Complete(Request *request, Result result);
+            Request *PopCompletedRequest(bool wait);
+
+            static void ExecuteRequest(s32 index, void *arg);
+    };
+
+}
@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) Atmosphère-NX
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms and conditions of the GNU General Public License,
+ * version 2, as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+#include <vapours.hpp>
+#include <stratosphere/os.hpp>
+
+namespace ams::fssystem {
+
+    class ThreadPool {
+        NON_COPYABLE(ThreadPool);
+        NON_MOVEABLE(ThreadPool);
+        public:
+            static constexpr s32 ThreadCountMax = 4;
+
+            using ParallelFunction = void (*)(s32 index, void *arg);
+        private:
+            struct Job : public util::IntrusiveListBaseNode<Job> {
+                ParallelFunction function;
+                void *argument;
+                s32 count;
+                s32 next;
+                s32 completed;
+            };
+
+            using JobList = util::IntrusiveListBaseTraits<Job>::ListType;
+        public:
+            /* Caller-owned storage for a job submitted with ExecuteAsync. */
+            class AsyncTask {
+                NON_COPYABLE(AsyncTask);
+                NON_MOVEABLE(AsyncTask);
+                friend class ThreadPool;
+                private:
+                    Job m_job;
+                public:
+                    AsyncTask() : m_job() {
+                        m_job.count     = 0;
+                        m_job.completed = 0;
+                    }
+            };
+        private:
+            os::ThreadType m_threads[ThreadCountMax];
+            s32 m_thread_count;
+            size_t m_thread_stack_size;
+            JobList m_jobs;
+            os::SdkMutex m_mutex;
+            os::SdkConditionVariable m_job_cv;
+            os::SdkConditionVariable m_done_cv;
+            bool m_finalizing;
+        public:
+            ThreadPool() : m_threads(), m_thread_count(0), m_thread_stack_size(0), m_jobs(), m_mutex(), m_job_cv(), m_done_cv(), m_finalizing(false) { /* ... */ }
+
+            ~ThreadPool() {
+                this->Finalize();
+            }
+
+            Result Initialize(s32 thread_count, void *stack_buffer, size_t stack_buffer_size, s32 priority);
+            void Finalize();
+
+            s32 GetThreadCount() const { return m_thread_count; }
+            size_t GetThreadStackSize() const { return m_thread_stack_size; }
+
+            /* Invokes function(i, arg) for each i in [0, count), on the calling thread and any idle workers. */
+            /* Index zero is always invoked on the calling thread. Returns once every invocation has completed. */
+            void ExecuteParallel(ParallelFunction function, void *arg, s32 count);
+
+            /* Queues function(0, arg) to run on a worker, without waiting for it. Fails if we have no workers, or the task is still pending. */
+            /* The task must be waited upon with WaitAsync before it (or anything the function uses) is destroyed. */
+            bool TryExecuteAsync(AsyncTask *task, ParallelFunction function, void *arg);
+            void WaitAsync(AsyncTask *task);
+        private:
+            static void ThreadEntry(void *arg);
+
+            void ThreadFunction();
+            void ExecuteOneLocked(Job *job);
+    };
+
+    void RegisterThreadPool(ThreadPool *pool);
+    ThreadPool *GetRegisteredThreadPool();
+
+    /* Executes a two-stage pipeline over chunk_count chunks, where stage 0 of chunk i runs concurrently with stage 1 of chunk i - 1. */
+    /* Stage 0 always runs on the calling thread. When no thread pool is provided, the stages run serially. */
+    template<typename Stage0, typename Stage1>
+    Result ExecutePipelined(ThreadPool *thread_pool, s32 chunk_count, Stage0 stage0, Stage1 stage1) {
+        /* Without workers, there's nothing to overlap. */
+        if (thread_pool == nullptr || thread_pool->GetThreadCount() == 0) {
+            for (s32 i = 0; i < chunk_count; ++i) {
+                R_TRY(stage0(i));
+                R_TRY(stage1(i));
+            }
+            return ResultSuccess();
+        }
+
+        struct Context {
+            Stage0 *stage0;
+            Stage1 *stage1;
+            s32 step;
+            Result results[2];
+        };
+
+        Context ctx = { std::addressof(stage0), std::addressof(stage1), 0, { ResultSuccess(), ResultSuccess() } };
+
+        auto execute_step = [](s32 index, void *arg) {
+            auto *ctx = static_cast<Context *>(arg);
+            if (index == 0) {
+                ctx->results[0] = (*ctx->stage0)(ctx->step);
+            } else {
+                ctx->results[1] = (*ctx->stage1)(ctx->step - 1);
+            }
+        };
+
+        /* Fill the pipeline. */
+        if (chunk_count > 0) {
+            R_TRY(stage0(0));
+        }
+
+        /* Run both stages together while there's work for both. */
+        for (s32 step = 1; step < chunk_count; ++step) {
+            ctx.step = step;
+            thread_pool->ExecuteParallel(execute_step, std::addressof(ctx), 2);
+
+            R_TRY(ctx.results[0]);
+            R_TRY(ctx.results[1]);
+        }
+
+        /* Drain the pipeline. */
+        if (chunk_count > 0) {
+            R_TRY(stage1(chunk_count - 1));
+        }
+
+        return ResultSuccess();
+    }
+
+}
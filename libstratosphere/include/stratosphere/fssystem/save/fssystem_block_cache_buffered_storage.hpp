@@ -20,6 +20,7 @@
 #include <stratosphere/fs/fs_istorage.hpp>
 #include <stratosphere/fs/fs_memory_management.hpp>
 #include <stratosphere/fssystem/save/fssystem_i_save_file_system_driver.hpp>
+#include <stratosphere/fssystem/save/fssystem_cache_replacement_policy.hpp>
 #include <stratosphere/fssystem/buffers/fssystem_file_system_buffer_manager.hpp>
 
 namespace ams::fssystem::save {
@@ -49,16 +50,20 @@ namespace ams::fssystem::save {
                 bool is_write_back;
                 bool is_cached;
                 bool is_flushing;
+                bool is_frequent;
+                bool is_pinned;
                 s64 offset;
                 IBufferManager::CacheHandle handle;
                 uintptr_t memory_address;
                 size_t memory_size;
+                u64 access_sequence;
             };
             static_assert(util::is_pod<CacheEntry>::value);
 
             enum Flag : s32 {
                 Flag_KeepBurstMode = (1 << 8),
                 Flag_RealData      = (1 << 10),
+                Flag_PinnedCache   = (1 << 11),
             };
         private:
             IBufferManager *m_buffer_manager;
@@ -71,14 +76,21 @@ namespace ams::fssystem::save {
             size_t m_verification_block_shift;
             CacheIndex m_invalidate_index;
             s32 m_max_cache_entry_count;
+            s32 m_cache_entry_capacity;
             s32 m_flags;
             s32 m_buffer_level;
             fs::StorageType m_storage_type;
+            CacheReplacementPolicy m_replacement_policy;
+            CacheEvictionHistory m_eviction_history;
+            u64 m_access_sequence;
+            s64 m_hit_count;
+            s64 m_miss_count;
+            s64 m_eviction_count;
         public:
             BlockCacheBufferedStorage();
             virtual ~BlockCacheBufferedStorage() override;
 
-            Result Initialize(IBufferManager *bm, os::SdkRecursiveMutex *mtx, IStorage *data, s64 data_size, size_t verif_block_size, s32 max_cache_entries, bool is_real_data, s8 buffer_level, bool is_keep_burst_mode, fs::StorageType storage_type);
+            Result Initialize(IBufferManager *bm, os::SdkRecursiveMutex *mtx, IStorage *data, s64 data_size, size_t verif_block_size, s32 max_cache_entries, bool is_real_data, s8 buffer_level, bool is_keep_burst_mode, fs::StorageType storage_type, CacheReplacementPolicy replacement_policy = CacheReplacementPolicy_Lru, s32 cache_entry_capacity = 0);
             void Finalize();
 
             virtual Result Read(s64 offset, void *buffer, size_t size) override;
@@ -118,16 +130,51 @@ namespace ams::fssystem::save {
                     m_flags &= ~Flag_RealData;
                 }
             }
-        private:
+
+            bool IsPinnedCache() const {
+                return (m_flags & Flag_PinnedCache) != 0;
+            }
+
+            /* A pinned cache holds its buffers itself, rather than registering them with the buffer manager, so that other */
+            /* users of the buffer manager can't evict them. Pinned buffers are capped across all storages; past the cap, */
+            /* buffers are registered as usual. This must be set before the cache is first used. */
+            void SetPinnedCache(bool en) {
+                if (en) {
+                    m_flags |= Flag_PinnedCache;
+                } else {
+                    m_flags &= ~Flag_PinnedCache;
+                }
+            }
+
             s32 GetMaxCacheEntryCount() const {
                 return m_max_cache_entry_count;
             }
 
+            s32 GetCacheEntryCapacity() const {
+                return m_cache_entry_capacity;
+            }
+
+            /* Changes how many cache entries may be used, up to the capacity given at initialization. */
+            Result SetMaxCacheEntryCount(s32 count);
+
+            s64 GetCacheHitCount() const { return m_hit_count; }
+            s64 GetCacheMissCount() const { return m_miss_count; }
+            s64 GetCacheEvictionCount() const { return m_eviction_count; }
+        private:
+            bool HoldsBuffer(const CacheEntry &entry) const {
+                return entry.is_write_back || entry.is_pinned;
+            }
+
+            void PinBuffer(CacheEntry *entry, const MemoryRange &range);
+            void UnpinBuffer(CacheEntry *entry);
+
             Result ClearImpl(s64 offset, s64 size);
             Result ClearSignatureImpl(s64 offset, s64 size);
             Result InvalidateCacheImpl(s64 offset, s64 size);
             Result QueryRangeImpl(void *dst, size_t dst_size, s64 offset, s64 size);
 
+            CacheIndex SelectInvalidateIndex();
+
             bool ExistsRedundantCacheEntry(const CacheEntry &entry) const;
 
             Result GetAssociateBuffer(MemoryRange *out_range, CacheEntry *out_entry, s64 offset, size_t ideal_size, bool is_allocate_for_write);
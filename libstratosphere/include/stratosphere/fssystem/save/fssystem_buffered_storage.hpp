@@ -19,12 +19,20 @@
 #include <stratosphere/fs/fs_istorage.hpp>
 #include <stratosphere/fs/fs_substorage.hpp>
 #include <stratosphere/fssystem/buffers/fssystem_i_buffer_manager.hpp>
+#include <stratosphere/fssystem/save/fssystem_cache_replacement_policy.hpp>
+#include <stratosphere/fssystem/fssystem_thread_pool.hpp>
 
 namespace ams::fssystem::save {
 
     class BufferedStorage : public ::ams::fs::IStorage {
         NON_COPYABLE(BufferedStorage);
         NON_MOVEABLE(BufferedStorage);
+        public:
+            static constexpr s32 ReadAheadSequentialCountMin = 2;
+            static constexpr s32 ReadAheadDepthMax           = 4;
+
+            /* Read-ahead issues whole base storage reads (decryption, ipc to the host file system) from a worker thread. */
+            static constexpr size_t ReadAheadThreadStackSizeMin = 32_KB;
         private:
             class Cache;
             class UniqueCache;
@@ -40,11 +48,22 @@ namespace ams::fssystem::save {
             Cache *m_next_fetch_cache;
             os::SdkMutex m_mutex;
             bool m_bulk_read_enabled;
+            CacheReplacementPolicy m_replacement_policy;
+            CacheEvictionHistory m_eviction_history;
+            std::atomic<s64> m_hit_count;
+            std::atomic<s64> m_miss_count;
+            ThreadPool *m_read_ahead_thread_pool;
+            ThreadPool::AsyncTask m_read_ahead_task;
+            s64 m_sequential_offset;
+            s32 m_sequential_count;
+            s32 m_read_ahead_depth;
+            s64 m_read_ahead_offset;
+            s64 m_read_ahead_offset_end;
         public:
             BufferedStorage();
             virtual ~BufferedStorage();
 
-            Result Initialize(fs::SubStorage base_storage, IBufferManager *buffer_manager, size_t block_size, s32 buffer_count);
+            Result Initialize(fs::SubStorage base_storage, IBufferManager *buffer_manager, size_t block_size, s32 buffer_count, CacheReplacementPolicy replacement_policy = CacheReplacementPolicy_Lru);
             void Finalize();
 
             bool IsInitialized() const { return m_caches != nullptr; }
@@ -64,7 +83,27 @@ namespace ams::fssystem::save {
             IBufferManager *GetBufferManager() const { return m_buffer_manager; }
 
             void EnableBulkRead() { m_bulk_read_enabled = true; }
+
+            /* Enables prefetching ahead of sequential reads on the registered thread pool. Intended for read-only storages. */
+            /* Pools whose workers' stacks are too small to safely perform base storage reads are not used. */
+            void EnableReadAhead() {
+                if (auto *thread_pool = GetRegisteredThreadPool(); thread_pool != nullptr && thread_pool->GetThreadStackSize() >= ReadAheadThreadStackSizeMin) {
+                    m_read_ahead_thread_pool = thread_pool;
+                }
+            }
+
+            s64 GetCacheHitCount() const { return m_hit_count.load(); }
+            s64 GetCacheMissCount() const { return m_miss_count.load(); }
         private:
+            Cache *SelectFetchCache();
+            bool UpdateEvictionHistory(s64 evicted_offset, s64 fetched_offset);
+
+            bool IsUnderMemoryPressure() const;
+            void UpdateReadAhead(s64 offset, size_t size);
+            void WaitReadAhead();
+            void ReadAhead();
+            static void ReadAheadFunction(s32 index, void *arg);
+
             Result PrepareAllocation();
             Result ControlDirtiness();
             Result ReadCore(s64 offset, void *buffer, size_t size);
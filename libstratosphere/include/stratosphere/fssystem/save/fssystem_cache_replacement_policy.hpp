@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) Atmosphère-NX
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms and conditions of the GNU General Public License,
+ * version 2, as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+#include <vapours.hpp>
+
+namespace ams::fssystem::save {
+
+    enum CacheReplacementPolicy {
+        /* Evict the least recently stored entry. */
+        CacheReplacementPolicy_Lru      = 0,
+
+        /* 2Q: entries start out probationary, and only become protected when hit again (or when re-fetched shortly after */
+        /* eviction). Probationary entries are evicted first once they exceed a quarter of the cache, so a single large */
+        /* sequential read cannot flush frequently used blocks. */
+        CacheReplacementPolicy_TwoQueue = 1,
+    };
+
+    /* Ghost list of recently evicted probationary offsets, used by the 2Q policy to detect re-references. */
+    class CacheEvictionHistory {
+        public:
+            static constexpr size_t HistoryCount = 16;
+            static constexpr s64 InvalidOffset   = -1;
+        private:
+            s64 m_offsets[HistoryCount];
+            size_t m_next_index;
+        public:
+            constexpr CacheEvictionHistory() : m_offsets(), m_next_index(0) {
+                this->Clear();
+            }
+
+            constexpr void Clear() {
+                for (auto &offset : m_offsets) {
+                    offset = InvalidOffset;
+                }
+                m_next_index = 0;
+            }
+
+            constexpr void Push(s64 offset) {
+                m_offsets[m_next_index] = offset;
+                m_next_index = (m_next_index + 1) % HistoryCount;
+            }
+
+            constexpr bool Remove(s64 offset) {
+                for (auto &entry : m_offsets) {
+                    if (entry == offset) {
+                        entry = InvalidOffset;
+                        return true;
+                    }
+                }
+                return false;
+            }
+    };
+
+    constexpr inline s32 GetTwoQueueProbationCountMax(s32 cache_count) {
+        return std::max<s32>(1, cache_count / 4);
+    }
+
+}
@@ -54,6 +54,23 @@ namespace ams::fssystem::save {
     };
     static_assert(util::is_pod<HierarchicalIntegrityVerificationInformation>::value);
 
+    /* Output of HierarchicalIntegrityVerificationStorage::QueryCacheStatistics; levels are ordered from the top hash level down to the data level. */
+    struct HierarchicalIntegrityVerificationCacheStatistics {
+        struct Level {
+            s64 hit_count;
+            s64 miss_count;
+            s64 eviction_count;
+            s32 cache_entry_count;
+            u8 reserved[4];
+        };
+        static_assert(util::is_pod<Level>::value);
+
+        s32 level_count;
+        u8 reserved[4];
+        Level levels[IntegrityMaxLayerCount - 1];
+    };
+    static_assert(util::is_pod<HierarchicalIntegrityVerificationCacheStatistics>::value);
+
     struct HierarchicalIntegrityVerificationMetaInformation {
         u32 magic;
         u32 version;
@@ -153,8 +170,13 @@ namespace ams::fssystem::save {
             s64 m_data_size;
             s32 m_max_layers;
             bool m_is_written_for_rollback;
+            bool m_is_adaptive_cache_sizing_enabled;
+            s32 m_cache_entry_count_min[MaxLayers - 1];
+            s64 m_last_miss_counts[MaxLayers - 1];
+            s64 m_last_rebalance_access_count;
+            std::atomic<u32> m_read_count;
         public:
-            HierarchicalIntegrityVerificationStorage() : m_buffers(nullptr), m_mutex(nullptr), m_data_size(-1), m_is_written_for_rollback(false) { /* ... */ }
+            HierarchicalIntegrityVerificationStorage() : m_buffers(nullptr), m_mutex(nullptr), m_data_size(-1), m_is_written_for_rollback(false), m_is_adaptive_cache_sizing_enabled(false), m_cache_entry_count_min(), m_last_miss_counts(), m_last_rebalance_access_count(0), m_read_count(0) { /* ... */ }
             virtual ~HierarchicalIntegrityVerificationStorage() override { this->Finalize(); }
 
             Result Initialize(const HierarchicalIntegrityVerificationInformation &info, HierarchicalStorageInformation storage, FileSystemBufferManagerSet *bufs, os::SdkRecursiveMutex *mtx, fs::StorageType storage_type);
@@ -182,6 +204,14 @@ namespace ams::fssystem::save {
                 return m_is_written_for_rollback;
             }
 
+            /* When enabled, cache entries are periodically moved from levels which rarely miss to levels which often do. */
+            /* The total entry count across levels never changes, and hash levels never shrink below their initial size. */
+            void SetAdaptiveCacheSizingEnabled(bool en) {
+                m_is_adaptive_cache_sizing_enabled = en;
+            }
+
+            void QueryCacheStatistics(HierarchicalIntegrityVerificationCacheStatistics *out);
+
             FileSystemBufferManagerSet *GetBuffers() {
                 return m_buffers;
             }
@@ -200,6 +230,8 @@ namespace ams::fssystem::save {
             fs::SubStorage GetL1HashStorage() {
                 return fs::SubStorage(std::addressof(m_buffer_storages[m_max_layers - 3]), 0, util::DivideUp(m_data_size, this->GetL1HashVerificationBlockSize()));
             }
+        private:
+            Result RebalanceCacheEntries();
     };
 
 }
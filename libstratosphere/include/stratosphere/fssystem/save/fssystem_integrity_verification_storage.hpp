@@ -23,6 +23,7 @@
 #include <stratosphere/fssystem/save/fssystem_save_types.hpp>
 #include <stratosphere/fssystem/save/fssystem_i_save_file_system_driver.hpp>
 #include <stratosphere/fssystem/save/fssystem_block_cache_buffered_storage.hpp>
+#include <stratosphere/fssystem/fssystem_thread_pool.hpp>
 
 namespace ams::fssystem::save {
 
@@ -47,8 +48,14 @@ namespace ams::fssystem::save {
             fs::HashSalt m_salt;
             bool m_is_real_data;
             fs::StorageType m_storage_type;
+            ThreadPool *m_prefetch_thread_pool;
+            ThreadPool::AsyncTask m_prefetch_task;
+            os::SdkMutex m_prefetch_mutex;
+            s64 m_sequential_offset;
+            s64 m_prefetch_sign_offset;
+            s64 m_prefetch_sign_offset_end;
         public:
-            IntegrityVerificationStorage() : m_verification_block_size(0), m_verification_block_order(0), m_upper_layer_verification_block_size(0), m_upper_layer_verification_block_order(0), m_buffer_manager(nullptr) { /* ... */ }
+            IntegrityVerificationStorage() : m_verification_block_size(0), m_verification_block_order(0), m_upper_layer_verification_block_size(0), m_upper_layer_verification_block_order(0), m_buffer_manager(nullptr), m_prefetch_thread_pool(nullptr), m_prefetch_task(), m_prefetch_mutex(), m_sequential_offset(-1), m_prefetch_sign_offset(0), m_prefetch_sign_offset_end(0) { /* ... */ }
             virtual ~IntegrityVerificationStorage() override { this->Finalize(); }
 
             Result Initialize(fs::SubStorage hs, fs::SubStorage ds, s64 verif_block_size, s64 upper_layer_verif_block_size, IBufferManager *bm, const fs::HashSalt &salt, bool is_real_data, fs::StorageType storage_type);
@@ -70,10 +77,20 @@ namespace ams::fssystem::save {
             s64 GetBlockSize() const {
                 return m_verification_block_size;
             }
+
+            /* Enables prefetching the next page of block signatures ahead of sequential reads, on the registered thread pool. */
+            /* The hash storage must be safe to read concurrently with our users. */
+            void EnableSignaturePrefetch() { m_prefetch_thread_pool = GetRegisteredThreadPool(); }
         private:
+            void UpdateSignaturePrefetch(s64 offset, size_t size);
+            void WaitSignaturePrefetch();
+            void PrefetchSignature();
+            static void PrefetchSignatureFunction(s32 index, void *arg);
+
             Result ReadBlockSignature(void *dst, size_t dst_size, s64 offset, size_t size);
             Result WriteBlockSignature(const void *src, size_t src_size, s64 offset, size_t size);
             Result VerifyHash(const void *buf, BlockHash *hash);
+            Result VerifyCalculatedHash(const BlockHash &calc_hash, BlockHash *hash);
 
             void CalcBlockHash(BlockHash *out, const void *buffer) const {
                 return this->CalcBlockHash(out, buffer, static_cast<size_t>(m_verification_block_size));
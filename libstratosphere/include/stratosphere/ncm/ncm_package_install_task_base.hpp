@@ -26,10 +26,16 @@ namespace ams::ncm {
             PackagePath m_package_root;
             void *m_buffer;
             size_t m_buffer_size;
+            void *m_reader_thread_stack;
+            size_t m_reader_thread_stack_size;
         public:
-            PackageInstallTaskBase() : m_package_root() { /* ... */ }
+            PackageInstallTaskBase() : m_package_root(), m_reader_thread_stack(nullptr), m_reader_thread_stack_size(0) { /* ... */ }
 
             Result Initialize(const char *package_root_path, void *buffer, size_t buffer_size, StorageId storage_id, InstallTaskDataBase *data, u32 config);
+
+            /* Reads the next part of each content on a thread running on the given stack while the current part is written. */
+            /* The install buffer is split in two for this, so each write covers at most half of it. */
+            void EnablePipelinedWrite(void *stack, size_t stack_size);
         protected:
             const char *GetPackageRootPath() {
                 return m_package_root.Get();
@@ -38,6 +44,8 @@ namespace ams::ncm {
             virtual Result OnWritePlaceHolder(const ContentMetaKey &key, InstallContentInfo *content_info) override;
             virtual Result InstallTicket(const fs::RightsId &rights_id, ContentMetaType meta_type) override;
 
+            Result WritePlaceHolderPipelined(InstallContentInfo *content_info, fs::FileHandle file);
+
             void CreateContentMetaPath(PackagePath *out_path, ContentId content_id);
             void CreateContentPath(PackagePath *out_path, ContentId content_id);
             void CreateTicketPath(PackagePath *out_path, fs::RightsId id);
@@ -22,10 +22,13 @@ namespace ams::os {
 
     struct MultiWaitHolderType;
     struct MultiWaitType;
+    struct MultiWaitHolderCacheType;
 
     void InitializeMultiWait(MultiWaitType *multi_wait);
     void FinalizeMultiWait(MultiWaitType *multi_wait);
 
+    void AttachMultiWaitHolderCache(MultiWaitType *multi_wait, MultiWaitHolderCacheType *cache);
+
     MultiWaitHolderType *WaitAny(MultiWaitType *multi_wait);
     MultiWaitHolderType *TryWaitAny(MultiWaitType *multi_wait);
     MultiWaitHolderType *TimedWaitAny(MultiWaitType *multi_wait, TimeSpan timeout);
@@ -23,6 +23,10 @@ namespace ams::os {
 
         class MultiWaitImpl;
         struct MultiWaitHolderImpl;
+        struct MultiWaitHolderCacheImpl;
+
+        constexpr inline size_t MultiWaitHandleCacheCount     = svc::ArgumentHandleCountMax;
+        constexpr inline size_t MultiWaitUserObjectCacheCount = 8;
 
     }
 
@@ -34,10 +38,15 @@ namespace ams::os {
 
         u8 state;
         bool is_waiting;
-        util::TypedStorage<impl::MultiWaitImpl, sizeof(util::IntrusiveListNode) + sizeof(impl::InternalCriticalSection) + 2 * sizeof(void *) + sizeof(Handle), alignof(void *)> impl_storage;
+        util::TypedStorage<impl::MultiWaitImpl, sizeof(util::IntrusiveListNode) + sizeof(impl::InternalCriticalSection) + 2 * sizeof(void *) + sizeof(Handle) + sizeof(void *) + 3 * sizeof(s32), alignof(void *)> impl_storage;
     };
     static_assert(std::is_trivial<MultiWaitType>::value);
 
+    struct MultiWaitHolderCacheType {
+        util::TypedStorage<impl::MultiWaitHolderCacheImpl, impl::MultiWaitHandleCacheCount * (sizeof(Handle) + sizeof(void *)) + impl::MultiWaitUserObjectCacheCount * sizeof(void *), alignof(void *)> impl_storage;
+    };
+    static_assert(std::is_trivial<MultiWaitHolderCacheType>::value);
+
     struct MultiWaitHolderType {
         util::TypedStorage<impl::MultiWaitHolderImpl, 2 * sizeof(util::IntrusiveListNode) + 3 * sizeof(void *), alignof(void *)> impl_storage;
         uintptr_t user_data;
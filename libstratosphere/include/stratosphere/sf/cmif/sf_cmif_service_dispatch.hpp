@@ -70,8 +70,8 @@ namespace ams::sf::cmif {
 
         class ServiceDispatchTableBase {
             protected:
-                Result ProcessMessageImpl(ServiceDispatchContext &ctx, const cmif::PointerAndSize &in_raw_data, const ServiceCommandMeta *entries, const size_t entry_count) const;
-                Result ProcessMessageForMitmImpl(ServiceDispatchContext &ctx, const cmif::PointerAndSize &in_raw_data, const ServiceCommandMeta *entries, const size_t entry_count) const;
+                Result ProcessMessageImpl(ServiceDispatchContext &ctx, const cmif::PointerAndSize &in_raw_data, const ServiceCommandMeta *entries, const u16 *sorted_indices, const size_t entry_count) const;
+                Result ProcessMessageForMitmImpl(ServiceDispatchContext &ctx, const cmif::PointerAndSize &in_raw_data, const ServiceCommandMeta *entries, const u16 *sorted_indices, const size_t entry_count) const;
             public:
                 /* CRTP. */
                 template<typename T>
@@ -91,17 +91,34 @@ namespace ams::sf::cmif {
         class ServiceDispatchTableImpl : public ServiceDispatchTableBase {
             public:
                 static constexpr size_t NumEntries = N;
+
+                static_assert(N <= std::numeric_limits<u16>::max());
             private:
                 const std::array<ServiceCommandMeta, N> m_entries;
+                const std::array<u16, N> m_sorted_indices;
+            private:
+                static constexpr std::array<u16, N> MakeSortedIndices(const std::array<ServiceCommandMeta, N> &e) {
+                    /* Stable insertion sort by command id, so that entries sharing an id keep their declaration order. */
+                    std::array<u16, N> indices{};
+                    for (size_t i = 0; i < N; ++i) {
+                        size_t j = i;
+                        while (j > 0 && e[indices[j - 1]].cmd_id > e[i].cmd_id) {
+                            indices[j] = indices[j - 1];
+                            --j;
+                        }
+                        indices[j] = static_cast<u16>(i);
+                    }
+                    return indices;
+                }
             public:
-                explicit constexpr ServiceDispatchTableImpl(const std::array<ServiceCommandMeta, N> &e) : m_entries{e} { /* ... */ }
+                explicit constexpr ServiceDispatchTableImpl(const std::array<ServiceCommandMeta, N> &e) : m_entries{e}, m_sorted_indices{MakeSortedIndices(e)} { /* ... */ }
 
                 Result ProcessMessage(ServiceDispatchContext &ctx, const cmif::PointerAndSize &in_raw_data) const {
-                    return this->ProcessMessageImpl(ctx, in_raw_data, m_entries.data(), m_entries.size());
+                    return this->ProcessMessageImpl(ctx, in_raw_data, m_entries.data(), m_sorted_indices.data(), m_entries.size());
                 }
 
                 Result ProcessMessageForMitm(ServiceDispatchContext &ctx, const cmif::PointerAndSize &in_raw_data) const {
-                    return this->ProcessMessageForMitmImpl(ctx, in_raw_data, m_entries.data(), m_entries.size());
+                    return this->ProcessMessageForMitmImpl(ctx, in_raw_data, m_entries.data(), m_sorted_indices.data(), m_entries.size());
                 }
 
                 constexpr const std::array<ServiceCommandMeta, N> &GetEntries() const {
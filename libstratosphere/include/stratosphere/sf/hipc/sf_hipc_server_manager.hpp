@@ -26,6 +26,7 @@ namespace ams::sf::hipc {
         static constexpr size_t MaxDomainObjects = 0;
         static constexpr bool CanDeferInvokeRequest = false;
         static constexpr bool CanManageMitmServers  = false;
+        static constexpr s32 ProcessingPartitionCount = 1;
     };
 
     static constexpr size_t ServerSessionCountMax = 0x40;
@@ -39,6 +40,8 @@ namespace ams::sf::hipc {
         NON_MOVEABLE(ServerManagerBase);
         public:
             using MitmQueryFunction = bool (*)(const sm::MitmProcessInfo &);
+
+            static constexpr s32 ProcessingPartitionCountMax = 4;
         private:
             enum class UserDataTag : uintptr_t {
                 Server      = 1,
@@ -46,6 +49,26 @@ namespace ams::sf::hipc {
                 MitmServer  = 3,
             };
         protected:
+            /* A set of holders waited upon by one processing thread. */
+            struct ProcessingPartition {
+                os::MultiWaitType multi_wait;
+                os::MultiWaitHolderCacheType multi_wait_cache;
+                os::MultiWaitHolderType request_stop_event_holder;
+                os::Event notify_event;
+                os::MultiWaitHolderType notify_event_holder;
+
+                os::SdkMutex selection_mutex;
+
+                os::SdkMutex deferred_list_mutex;
+                os::MultiWaitType deferred_list;
+
+                /* NOTE: Only changed under the manager's partition mutex, but read without it by threads looking for work. */
+                std::atomic<os::ThreadType *> owner_thread;
+                std::atomic<bool> is_busy;
+
+                ProcessingPartition() : notify_event(os::EventClearMode_ManualClear), selection_mutex(), deferred_list_mutex(), owner_thread(nullptr), is_busy(false) { /* ... */ }
+            };
+
             using ServerDomainSessionManager::DomainEntryStorage;
             using ServerDomainSessionManager::DomainStorage;
         protected:
@@ -79,16 +102,13 @@ namespace ams::sf::hipc {
             static constinit inline bool g_is_any_mitm_supported = false;
         private:
             /* Multiple wait management. */
-            os::MultiWaitType m_multi_wait;
             os::Event m_request_stop_event;
-            os::MultiWaitHolderType m_request_stop_event_holder;
-            os::Event m_notify_event;
-            os::MultiWaitHolderType m_notify_event_holder;
-
-            os::SdkMutex m_selection_mutex;
-
-            os::SdkMutex m_deferred_list_mutex;
-            os::MultiWaitType m_deferred_list;
+            ProcessingPartition *m_partitions;
+            s32 m_partition_count_max;
+            s32 m_partition_count;
+            os::SdkMutex m_partition_mutex;
+            std::atomic<s32> m_busy_partition_count;
+            std::atomic<u32> m_next_partition_index;
 
             /* Boolean values. */
             const bool m_is_defer_supported;
@@ -96,9 +116,20 @@ namespace ams::sf::hipc {
         private:
             virtual void RegisterServerSessionToWait(ServerSession *session) override final;
             void LinkToDeferredList(os::MultiWaitHolderType *holder);
-            void LinkDeferred();
+            void LinkToDeferredList(ProcessingPartition *partition, os::MultiWaitHolderType *holder);
+            void LinkDeferred(ProcessingPartition *partition);
 
-            bool WaitAndProcessImpl();
+            ProcessingPartition *AcquireProcessingPartition();
+            void ReleaseProcessingPartition(ProcessingPartition *partition);
+            ProcessingPartition *FindOwnedProcessingPartition();
+            ProcessingPartition *SelectSharedProcessingPartition();
+            ProcessingPartition *FindFallbackProcessingPartition(const ProcessingPartition *exclude);
+            void SetProcessingPartitionBusy(ProcessingPartition *partition, bool busy);
+            void NotifyIdleProcessingPartition(ProcessingPartition *partition);
+            os::MultiWaitHolderType *TryStealSignaledSession(ProcessingPartition *partition);
+
+            os::MultiWaitHolderType *WaitSignaledImpl(ProcessingPartition *partition);
+            bool WaitAndProcessImpl(ProcessingPartition *partition);
 
             Result ProcessForServer(os::MultiWaitHolderType *holder);
             Result ProcessForMitmServer(os::MultiWaitHolderType *holder);
@@ -118,7 +149,7 @@ namespace ams::sf::hipc {
                     os::SetMultiWaitHolderUserData(server, static_cast<uintptr_t>(UserDataTag::Server));
                 }
 
-                os::LinkMultiWaitHolder(std::addressof(m_multi_wait), server);
+                this->LinkToDeferredList(server);
             }
 
             void RegisterServerImpl(int index, cmif::ServiceObjectHolder &&static_holder, os::NativeHandle port_handle, bool is_mitm_server) {
@@ -160,6 +191,28 @@ namespace ams::sf::hipc {
 
             Result InstallMitmServerImpl(os::NativeHandle *out_port_handle, sm::ServiceName service_name, MitmQueryFunction query_func);
         protected:
+            void InitializeProcessingPartitions(ProcessingPartition *partitions, s32 partition_count) {
+                AMS_ABORT_UNLESS(0 < partition_count && partition_count <= ProcessingPartitionCountMax);
+
+                m_partitions           = partitions;
+                m_partition_count_max  = partition_count;
+                m_partition_count      = 1;
+
+                /* Link multi-wait holders. */
+                for (s32 i = 0; i < partition_count; ++i) {
+                    auto &partition = m_partitions[i];
+
+                    os::InitializeMultiWait(std::addressof(partition.multi_wait));
+                    os::AttachMultiWaitHolderCache(std::addressof(partition.multi_wait), std::addressof(partition.multi_wait_cache));
+                    os::InitializeMultiWaitHolder(std::addressof(partition.request_stop_event_holder), m_request_stop_event.GetBase());
+                    os::LinkMultiWaitHolder(std::addressof(partition.multi_wait), std::addressof(partition.request_stop_event_holder));
+                    os::InitializeMultiWaitHolder(std::addressof(partition.notify_event_holder), partition.notify_event.GetBase());
+                    os::LinkMultiWaitHolder(std::addressof(partition.multi_wait), std::addressof(partition.notify_event_holder));
+
+                    os::InitializeMultiWait(std::addressof(partition.deferred_list));
+                }
+            }
+
             virtual Server *AllocateServer() = 0;
             virtual void DestroyServer(Server *server)  = 0;
             virtual Result OnNeedsToAccept(int port_index, Server *server) {
@@ -203,17 +256,10 @@ namespace ams::sf::hipc {
         public:
             ServerManagerBase(DomainEntryStorage *entry_storage, size_t entry_count, bool defer_supported, bool mitm_supported) :
                 ServerDomainSessionManager(entry_storage, entry_count),
-                m_request_stop_event(os::EventClearMode_ManualClear), m_notify_event(os::EventClearMode_ManualClear),
-                m_selection_mutex(), m_deferred_list_mutex(), m_is_defer_supported(defer_supported), m_is_mitm_supported(mitm_supported)
+                m_request_stop_event(os::EventClearMode_ManualClear), m_partitions(nullptr), m_partition_count_max(0), m_partition_count(0), m_partition_mutex(), m_busy_partition_count(0), m_next_partition_index(0),
+                m_is_defer_supported(defer_supported), m_is_mitm_supported(mitm_supported)
             {
-                /* Link multi-wait holders. */
-                os::InitializeMultiWait(std::addressof(m_multi_wait));
-                os::InitializeMultiWaitHolder(std::addressof(m_request_stop_event_holder), m_request_stop_event.GetBase());
-                os::LinkMultiWaitHolder(std::addressof(m_multi_wait), std::addressof(m_request_stop_event_holder));
-                os::InitializeMultiWaitHolder(std::addressof(m_notify_event_holder), m_notify_event.GetBase());
-                os::LinkMultiWaitHolder(std::addressof(m_multi_wait), std::addressof(m_notify_event_holder));
-
-                os::InitializeMultiWait(std::addressof(m_deferred_list));
+                /* ... */
             }
 
             static ALWAYS_INLINE bool CanAnyDeferInvokeRequest() {
@@ -250,6 +296,15 @@ namespace ams::sf::hipc {
                 return this->RegisterServerImpl(port_index, cmif::ServiceObjectHolder(), service_name, max_sessions);
             }
 
+            /* Partitions sessions across per-thread multi-waits, so that up to partition_count threads in LoopProcess */
+            /* each wait on their own sessions, and take signaled sessions from one another when idle. */
+            /* partition_count may not exceed the manager's ProcessingPartitionCount option. */
+            /* This must be called before any thread begins processing. */
+            void SetProcessingPartitionCount(s32 partition_count) {
+                AMS_ABORT_UNLESS(0 < partition_count && partition_count <= m_partition_count_max);
+                m_partition_count = partition_count;
+            }
+
             /* Processing. */
             os::MultiWaitHolderType *WaitSignaled();
 
@@ -278,6 +333,15 @@ namespace ams::sf::hipc {
                 }
             }();
             static_assert(DomainCountsValid, "Invalid Domain Counts");
+
+            static constexpr inline s32 ProcessingPartitionCount = [] {
+                if constexpr (requires { ManagerOptions::ProcessingPartitionCount; }) {
+                    return static_cast<s32>(ManagerOptions::ProcessingPartitionCount);
+                } else {
+                    return 1;
+                }
+            }();
+            static_assert(0 < ProcessingPartitionCount && ProcessingPartitionCount <= ProcessingPartitionCountMax, "Invalid Processing Partition Count");
         protected:
             using ServerManagerBase::DomainEntryStorage;
             using ServerManagerBase::DomainStorage;
@@ -297,6 +361,9 @@ namespace ams::sf::hipc {
             DomainStorage m_domain_storages[ManagerOptions::MaxDomains];
             bool m_domain_allocated[ManagerOptions::MaxDomains];
             DomainEntryStorage m_domain_entry_storages[ManagerOptions::MaxDomainObjects];
+
+            /* Processing partitions. */
+            ProcessingPartition m_processing_partitions[ProcessingPartitionCount];
         private:
             constexpr inline size_t GetServerIndex(const Server *server) const {
                 const size_t i = server - GetPointer(m_server_storages[0]);
@@ -426,6 +493,9 @@ namespace ams::sf::hipc {
                 m_pointer_buffers_start = util::AlignUp(reinterpret_cast<uintptr_t>(m_pointer_buffer_storage), 0x10);
                 m_saved_messages_start  = util::AlignUp(reinterpret_cast<uintptr_t>(m_saved_message_storage),  0x10);
 
+                /* Set up processing partitions. */
+                this->InitializeProcessingPartitions(m_processing_partitions, ProcessingPartitionCount);
+
                 /* Update globals. */
                 if constexpr (ManagerOptions::CanDeferInvokeRequest) {
                     ServerManagerBase::g_is_any_deferred_supported = true;
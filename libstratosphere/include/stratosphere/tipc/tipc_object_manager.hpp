@@ -30,16 +30,28 @@ namespace ams::tipc {
             struct Entry {
                 util::TypedStorage<ObjectHolder> object;
                 os::MultiWaitHolderType multi_wait_holder;
+                Entry *next; /* Next free entry, or next entry in the same handle bucket. */
             };
         private:
             os::SdkMutex m_mutex{};
             Entry *m_entries_start{};
             Entry *m_entries_end{};
+            Entry *m_free_list{};
+            Entry **m_handle_buckets{};
+            size_t m_handle_bucket_count{};
             os::MultiWaitType *m_multi_wait{};
         private:
-            Entry *FindEntry(os::NativeHandle handle) {
-                for (Entry *cur = m_entries_start; cur != m_entries_end; ++cur) {
-                    if (GetReference(cur->object).GetHandle() == handle) {
+            Entry **GetHandleBucket(os::NativeHandle handle) {
+                /* NOTE: The low bits of a handle are its index in the handle table, and so are already well distributed. */
+                const auto hash = static_cast<size_t>(handle) ^ (static_cast<size_t>(handle) >> 15);
+                return std::addressof(m_handle_buckets[hash & (m_handle_bucket_count - 1)]);
+            }
+
+            Entry *RemoveEntry(os::NativeHandle handle) {
+                for (Entry **link = this->GetHandleBucket(handle); *link != nullptr; link = std::addressof((*link)->next)) {
+                    if (Entry *cur = *link; GetReference(cur->object).GetHandle() == handle) {
+                        *link     = cur->next;
+                        cur->next = nullptr;
                         return cur;
                     }
                 }
@@ -47,17 +59,29 @@ namespace ams::tipc {
             }
 
             Entry *FindEntry(os::MultiWaitHolderType *holder) {
-                for (Entry *cur = m_entries_start; cur != m_entries_end; ++cur) {
-                    if (std::addressof(cur->multi_wait_holder) == holder) {
-                        return cur;
-                    }
+                /* Holders which aren't ours (e.g. for ports) lie outside our entries. */
+                const uintptr_t address = reinterpret_cast<uintptr_t>(holder);
+                const uintptr_t start   = reinterpret_cast<uintptr_t>(m_entries_start);
+                const uintptr_t end     = reinterpret_cast<uintptr_t>(m_entries_end);
+                if (address < start || address >= end) {
+                    return nullptr;
                 }
-                return nullptr;
+
+                /* Determine the entry from the holder's address. */
+                Entry *entry = m_entries_start + (address - start) / sizeof(Entry);
+                if (std::addressof(entry->multi_wait_holder) != holder) {
+                    return nullptr;
+                }
+
+                return entry;
             }
         public:
             constexpr ObjectManagerBase() = default;
 
-            void InitializeImpl(os::MultiWaitType *multi_wait, Entry *entries, size_t max_objects) {
+            void InitializeImpl(os::MultiWaitType *multi_wait, Entry *entries, size_t max_objects, Entry **handle_buckets, size_t handle_bucket_count) {
+                /* Validate our bucket count. */
+                AMS_ASSERT(util::IsPowerOfTwo(handle_bucket_count));
+
                 /* Set our multi wait. */
                 m_multi_wait = multi_wait;
 
@@ -65,9 +89,20 @@ namespace ams::tipc {
                 m_entries_start = entries;
                 m_entries_end   = entries + max_objects;
 
-                /* Construct all entries. */
-                for (size_t i = 0; i < max_objects; ++i) {
-                    util::ConstructAt(m_entries_start[i].object);
+                /* Setup our handle buckets. */
+                m_handle_buckets      = handle_buckets;
+                m_handle_bucket_count = handle_bucket_count;
+                for (size_t i = 0; i < handle_bucket_count; ++i) {
+                    m_handle_buckets[i] = nullptr;
+                }
+
+                /* Construct all entries, and add them to our free list in order. */
+                m_free_list = nullptr;
+                for (size_t i = max_objects; i > 0; --i) {
+                    util::ConstructAt(m_entries_start[i - 1].object);
+
+                    m_entries_start[i - 1].next = m_free_list;
+                    m_free_list = std::addressof(m_entries_start[i - 1]);
                 }
             }
 
@@ -75,13 +110,19 @@ namespace ams::tipc {
                 /* Lock ourselves. */
                 std::scoped_lock lk(m_mutex);
 
-                /* Find an empty entry. */
-                auto *entry = this->FindEntry(os::InvalidNativeHandle);
+                /* Take an empty entry. */
+                auto *entry = m_free_list;
                 AMS_ABORT_UNLESS(entry != nullptr);
+                m_free_list = entry->next;
 
                 /* Set the entry's object. */
                 GetReference(entry->object) = object;
 
+                /* Add the entry to its handle's bucket. */
+                Entry **bucket = this->GetHandleBucket(object.GetHandle());
+                entry->next = *bucket;
+                *bucket     = entry;
+
                 /* Setup the entry's holder. */
                 os::InitializeMultiWaitHolder(std::addressof(entry->multi_wait_holder), object.GetHandle());
                 os::LinkMultiWaitHolder(m_multi_wait, std::addressof(entry->multi_wait_holder));
@@ -91,8 +132,8 @@ namespace ams::tipc {
                 /* Lock ourselves. */
                 std::scoped_lock lk(m_mutex);
 
-                /* Find the matching entry. */
-                auto *entry = this->FindEntry(handle);
+                /* Find and remove the matching entry. */
+                auto *entry = this->RemoveEntry(handle);
                 AMS_ABORT_UNLESS(entry != nullptr);
 
                 /* Finalize the entry's holder. */
@@ -101,6 +142,12 @@ namespace ams::tipc {
 
                 /* Destroy the object. */
                 GetReference(entry->object).Destroy();
+
+                /* Return the entry to the head of our free list. */
+                /* NOTE: Entries are therefore reused most-recently-closed first, rather than lowest index first. */
+                /* Nothing depends on which entry an object gets; holders are waited on in the order they were linked. */
+                entry->next = m_free_list;
+                m_free_list = entry;
             }
 
             Result ReplyAndReceive(os::MultiWaitHolderType **out_holder, ObjectHolder *out_object, os::NativeHandle reply_target, os::MultiWaitType *multi_wait) {
@@ -203,13 +250,16 @@ namespace ams::tipc {
 
     template<size_t MaxObjects>
     class ObjectManager : public ObjectManagerBase {
+        private:
+            static constexpr size_t HandleBucketCount = util::CeilingPowerOfTwo(MaxObjects);
         private:
             Entry m_entries_storage[MaxObjects]{};
+            Entry *m_handle_buckets_storage[HandleBucketCount]{};
         public:
             constexpr ObjectManager() = default;
 
             void Initialize(os::MultiWaitType *multi_wait) {
-                this->InitializeImpl(multi_wait, m_entries_storage, MaxObjects);
+                this->InitializeImpl(multi_wait, m_entries_storage, MaxObjects, m_handle_buckets_storage, HandleBucketCount);
             }
     };
 
@@ -248,6 +248,57 @@ namespace ams::fs {
         return ResultSuccess();
     }
 
+    Result HierarchicalRomFileTable::IsFilePath(bool *out, RomFileId id, const RomPathChar *path, size_t path_length) {
+        AMS_ASSERT(out != nullptr);
+        AMS_ASSERT(path != nullptr);
+
+        /* Match entry names against the path's components, from its end towards its start. */
+        /* NOTE: Every match consumes at least the separator, so corrupted tables whose entries form a cycle can't loop forever. */
+        size_t remaining = path_length;
+        auto match_component = [&](const RomPathChar *name, size_t name_length) -> bool {
+            if (name_length >= remaining) {
+                return false;
+            }
+
+            const size_t start = remaining - name_length;
+            if (!RomPathTool::IsSeparator(path[start - 1]) || !RomPathTool::IsEqualPath(path + start, name, name_length)) {
+                return false;
+            }
+
+            remaining = start - 1;
+            return true;
+        };
+
+        RomPathChar name[MaxKeyLength + 1];
+        size_t aux_size = 0;
+
+        /* Check the file's own name. */
+        RomEntryKey key = {};
+        RomFileEntry file_entry = {};
+        R_TRY(m_file_table.GetByPosition(std::addressof(key), std::addressof(file_entry), name, std::addressof(aux_size), FileIdToPosition(id)));
+        AMS_ASSERT(aux_size / sizeof(RomPathChar) <= RomPathTool::MaxPathLength);
+
+        if (!match_component(name, aux_size / sizeof(RomPathChar))) {
+            *out = false;
+            return ResultSuccess();
+        }
+
+        /* Check the name of each ancestor directory, up to the root. */
+        while (key.parent != RootPosition) {
+            RomDirectoryEntry dir_entry = {};
+            R_TRY(m_dir_table.GetByPosition(std::addressof(key), std::addressof(dir_entry), name, std::addressof(aux_size), key.parent));
+            AMS_ASSERT(aux_size / sizeof(RomPathChar) <= RomPathTool::MaxPathLength);
+
+            if (!match_component(name, aux_size / sizeof(RomPathChar))) {
+                *out = false;
+                return ResultSuccess();
+            }
+        }
+
+        *out = remaining == 0;
+        return ResultSuccess();
+    }
+
     Result HierarchicalRomFileTable::FindOpen(FindPosition *out, const RomPathChar *path) {
         AMS_ASSERT(out != nullptr);
         AMS_ASSERT(path != nullptr);
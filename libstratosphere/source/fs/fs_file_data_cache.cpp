@@ -0,0 +1,293 @@
+/*
+ * Copyright (c) Atmosphère-NX
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms and conditions of the GNU General Public License,
+ * version 2, as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <stratosphere.hpp>
+#include "fs_file_data_cache.hpp"
+#include "fsa/fs_file_accessor.hpp"
+#include "fsa/fs_filesystem_accessor.hpp"
+#include "fsa/fs_user_mount_table.hpp"
+
+namespace ams::fs::impl {
+
+    namespace {
+
+        constinit os::SdkMutex g_global_file_data_cache_mutex;
+        constinit FileDataCache g_global_file_data_cache;
+        constinit std::atomic<bool> g_global_file_data_cache_enabled = false;
+
+    }
+
+    Result FileDataCache::Initialize(void *buffer, size_t buffer_size) {
+        /* Validate pre-conditions. */
+        AMS_ASSERT(!this->IsInitialized());
+        R_UNLESS(buffer != nullptr, fs::ResultNullptrArgument());
+
+        /* Align the buffer for our entries. */
+        const uintptr_t aligned_address = util::AlignUp(reinterpret_cast<uintptr_t>(buffer), alignof(Entry));
+        const size_t skip_size = aligned_address - reinterpret_cast<uintptr_t>(buffer);
+        R_UNLESS(buffer_size > skip_size, fs::ResultInvalidSize());
+
+        /* Determine how many blocks we can hold. */
+        const size_t entry_count = QueryEntryCount(buffer_size - skip_size);
+        R_UNLESS(entry_count > 0, fs::ResultInvalidSize());
+
+        /* Lay out our entries, followed by the block data. */
+        Entry *entries = reinterpret_cast<Entry *>(aligned_address);
+        char *data     = reinterpret_cast<char *>(entries + entry_count);
+        for (size_t i = 0; i < entry_count; ++i) {
+            entries[i] = {};
+            entries[i].state  = EntryState_Invalid;
+            entries[i].buffer = data + i * BlockSize;
+        }
+
+        std::scoped_lock lk(m_mutex);
+
+        m_entries      = entries;
+        m_entry_count  = static_cast<s32>(entry_count);
+        m_access_count = 0;
+        ++m_generation;
+
+        return ResultSuccess();
+    }
+
+    void FileDataCache::Finalize() {
+        std::scoped_lock lk(m_mutex);
+
+        /* NOTE: The caller guarantees that no reads are in progress. */
+        if (m_entries != nullptr) {
+            for (s32 i = 0; i < m_entry_count; ++i) {
+                AMS_ASSERT(m_entries[i].state != EntryState_Loading);
+            }
+        }
+
+        m_entries     = nullptr;
+        m_entry_count = 0;
+    }
+
+    Result FileDataCache::Read(size_t *out, FileAccessor *file, const FilePathHash &path_hash, s64 offset, void *buffer, size_t size, const ReadOption &option) {
+        /* Validate arguments, as the file itself would. */
+        R_UNLESS(out != nullptr, fs::ResultNullptrArgument());
+        if (size == 0) {
+            *out = 0;
+            return ResultSuccess();
+        }
+        R_UNLESS(buffer != nullptr, fs::ResultNullptrArgument());
+        R_UNLESS(offset >= 0,       fs::ResultOutOfRange());
+        R_UNLESS(static_cast<s64>(size) >= 0 && (std::numeric_limits<s64>::max() - offset) >= static_cast<s64>(size), fs::ResultOutOfRange());
+
+        /* Large reads gain nothing from the cache, so pass them through. */
+        if (size > ReadSizeMax) {
+            return file->ReadWithoutCacheAccessLog(out, offset, buffer, size, option);
+        }
+
+        /* Read each block, stopping early if we reach the end of the file. */
+        char *dst = static_cast<char *>(buffer);
+        size_t read_size = 0;
+        while (read_size < size) {
+            const s64 cur_offset      = offset + static_cast<s64>(read_size);
+            const s64 block_index     = cur_offset / static_cast<s64>(BlockSize);
+            const size_t block_offset = static_cast<size_t>(cur_offset % static_cast<s64>(BlockSize));
+            const size_t cur_size     = std::min(size - read_size, BlockSize - block_offset);
+
+            size_t cur_read_size = 0;
+            R_TRY(this->ReadBlock(std::addressof(cur_read_size), file, path_hash, block_index, block_offset, dst + read_size, cur_size, option));
+
+            read_size += cur_read_size;
+            if (cur_read_size < cur_size) {
+                break;
+            }
+        }
+
+        *out = read_size;
+        return ResultSuccess();
+    }
+
+    Result FileDataCache::ReadBlock(size_t *out, FileAccessor *file, const FilePathHash &path_hash, s64 block_index, size_t block_offset, void *buffer, size_t size, const ReadOption &option) {
+        const FileSystemAccessor *fs = file->GetParent();
+
+        /* Copies out the part of a block we want, checking that our offset is within the file. */
+        auto copy_from_block = [&](const char *block, size_t valid_size) -> Result {
+            R_UNLESS(block_offset <= valid_size, fs::ResultOutOfRange());
+
+            const size_t copy_size = std::min(size, valid_size - block_offset);
+            std::memcpy(buffer, block + block_offset, copy_size);
+
+            *out = copy_size;
+            return ResultSuccess();
+        };
+
+        /* Try to find the block in the cache, reserving an entry to load it into if it isn't present. */
+        Entry *entry;
+        u64 generation;
+        {
+            std::scoped_lock lk(m_mutex);
+
+            if (Entry *found = this->FindEntry(fs, path_hash, block_index); found != nullptr) {
+                found->last_used = ++m_access_count;
+                return copy_from_block(found->buffer, found->valid_size);
+            }
+
+            entry = this->AllocateEntry();
+            if (entry != nullptr) {
+                entry->fs          = fs;
+                entry->path_hash   = path_hash;
+                entry->block_index = block_index;
+                entry->state       = EntryState_Loading;
+            }
+
+            generation = m_generation;
+        }
+
+        /* If every entry is being loaded by someone else, read directly without caching. */
+        if (entry == nullptr) {
+            return file->ReadWithoutCacheAccessLog(out, block_index * static_cast<s64>(BlockSize) + static_cast<s64>(block_offset), buffer, size, option);
+        }
+
+        /* Read the whole block. */
+        size_t valid_size = 0;
+        const Result result = file->ReadWithoutCacheAccessLog(std::addressof(valid_size), block_index * static_cast<s64>(BlockSize), entry->buffer, BlockSize, option);
+
+        /* Copy out the data, while we still have exclusive ownership of the entry. */
+        Result copy_result = result;
+        if (R_SUCCEEDED(result)) {
+            copy_result = copy_from_block(entry->buffer, valid_size);
+        }
+
+        /* Publish the entry, unless the file was modified while we were loading it. */
+        {
+            std::scoped_lock lk(m_mutex);
+
+            if (R_SUCCEEDED(result) && generation == m_generation) {
+                entry->valid_size = valid_size;
+                entry->last_used  = ++m_access_count;
+                entry->state      = EntryState_Valid;
+            } else {
+                entry->state      = EntryState_Invalid;
+            }
+        }
+
+        return copy_result;
+    }
+
+    void FileDataCache::Invalidate(const FileSystemAccessor *fs, const FilePathHash &path_hash) {
+        std::scoped_lock lk(m_mutex);
+
+        /* Ensure that any in-progress loads are discarded. */
+        ++m_generation;
+
+        for (s32 i = 0; i < m_entry_count; ++i) {
+            auto &entry = m_entries[i];
+            if (entry.state == EntryState_Valid && entry.fs == fs && entry.path_hash == path_hash) {
+                entry.state = EntryState_Invalid;
+            }
+        }
+    }
+
+    void FileDataCache::Invalidate(const FileSystemAccessor *fs) {
+        std::scoped_lock lk(m_mutex);
+
+        /* Ensure that any in-progress loads are discarded. */
+        ++m_generation;
+
+        for (s32 i = 0; i < m_entry_count; ++i) {
+            auto &entry = m_entries[i];
+            if (entry.state == EntryState_Valid && entry.fs == fs) {
+                entry.state = EntryState_Invalid;
+            }
+        }
+    }
+
+    FileDataCache::Entry *FileDataCache::FindEntry(const FileSystemAccessor *fs, const FilePathHash &path_hash, s64 block_index) {
+        for (s32 i = 0; i < m_entry_count; ++i) {
+            auto &entry = m_entries[i];
+            if (entry.state == EntryState_Valid && entry.block_index == block_index && entry.fs == fs && entry.path_hash == path_hash) {
+                return std::addressof(entry);
+            }
+        }
+
+        return nullptr;
+    }
+
+    FileDataCache::Entry *FileDataCache::AllocateEntry() {
+        /* Prefer an unused entry, falling back to the least recently used valid entry. */
+        Entry *victim = nullptr;
+        for (s32 i = 0; i < m_entry_count; ++i) {
+            auto &entry = m_entries[i];
+            if (entry.state == EntryState_Invalid) {
+                return std::addressof(entry);
+            } else if (entry.state == EntryState_Valid && (victim == nullptr || entry.last_used < victim->last_used)) {
+                victim = std::addressof(entry);
+            }
+        }
+
+        return victim;
+    }
+
+    Result ComputeFilePathHash(FilePathHash *out, const char *path) {
+        /* Normalize the path, so that every spelling of a path refers to the same cached data. */
+        char normalized[EntryNameLengthMax + 1];
+        size_t normalized_len;
+        R_TRY(PathNormalizer::Normalize(normalized, std::addressof(normalized_len), path, sizeof(normalized)));
+
+        /* Hash the normalized path. */
+        u8 hash[crypto::Sha256Generator::HashSize];
+        crypto::GenerateSha256Hash(hash, sizeof(hash), normalized, normalized_len);
+
+        static_assert(sizeof(out->data) <= sizeof(hash));
+        std::memcpy(out->data, hash, sizeof(out->data));
+        return ResultSuccess();
+    }
+
+    FileDataCache *GetGlobalFileDataCache() {
+        return g_global_file_data_cache_enabled.load(std::memory_order_acquire) ? std::addressof(g_global_file_data_cache) : nullptr;
+    }
+
+}
+
+namespace ams::fs {
+
+    Result EnableGlobalFileDataCache(void *buffer, size_t size) {
+        std::scoped_lock lk(impl::g_global_file_data_cache_mutex);
+        R_UNLESS(!impl::g_global_file_data_cache_enabled.load(std::memory_order_relaxed), fs::ResultPreconditionViolation());
+
+        R_TRY(impl::g_global_file_data_cache.Initialize(buffer, size));
+
+        impl::g_global_file_data_cache_enabled.store(true, std::memory_order_release);
+        return ResultSuccess();
+    }
+
+    void DisableGlobalFileDataCache() {
+        std::scoped_lock lk(impl::g_global_file_data_cache_mutex);
+        if (impl::g_global_file_data_cache_enabled.load(std::memory_order_relaxed)) {
+            impl::g_global_file_data_cache_enabled.store(false, std::memory_order_release);
+            impl::g_global_file_data_cache.Finalize();
+        }
+    }
+
+    Result EnableIndividualFileDataCache(const char *mount_name, void *buffer, size_t size) {
+        impl::FileSystemAccessor *accessor;
+        R_TRY(impl::Find(std::addressof(accessor), mount_name));
+
+        return accessor->AttachPathBasedFileDataCache(buffer, size);
+    }
+
+    void DisableIndividualFileDataCache(const char *mount_name) {
+        impl::FileSystemAccessor *accessor;
+        if (R_SUCCEEDED(impl::Find(std::addressof(accessor), mount_name))) {
+            accessor->DetachPathBasedFileDataCache();
+        }
+    }
+
+}
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) Atmosphère-NX
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms and conditions of the GNU General Public License,
+ * version 2, as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+#include <stratosphere.hpp>
+#include "fs_file_path_hash.hpp"
+
+namespace ams::fs::impl {
+
+    class FileAccessor;
+    class FileSystemAccessor;
+
+    class FileDataCache : public Newable {
+        NON_COPYABLE(FileDataCache);
+        NON_MOVEABLE(FileDataCache);
+        public:
+            static constexpr size_t BlockSize   = 16_KB;
+            static constexpr size_t ReadSizeMax = 4 * BlockSize;
+        private:
+            enum EntryState : u8 {
+                EntryState_Invalid = 0,
+                EntryState_Loading = 1,
+                EntryState_Valid   = 2,
+            };
+
+            struct Entry {
+                const FileSystemAccessor *fs;
+                FilePathHash path_hash;
+                EntryState state;
+                s64 block_index;
+                char *buffer;
+                size_t valid_size;
+                u64 last_used;
+            };
+        private:
+            os::SdkMutex m_mutex;
+            Entry *m_entries;
+            s32 m_entry_count;
+            u64 m_access_count;
+            u64 m_generation;
+        public:
+            static size_t QueryEntryCount(size_t buffer_size) {
+                return buffer_size / (sizeof(Entry) + BlockSize);
+            }
+        public:
+            constexpr FileDataCache() : m_mutex(), m_entries(nullptr), m_entry_count(0), m_access_count(0), m_generation(0) { /* ... */ }
+
+            ~FileDataCache() {
+                this->Finalize();
+            }
+
+            Result Initialize(void *buffer, size_t buffer_size);
+            void Finalize();
+
+            bool IsInitialized() const { return m_entries != nullptr; }
+
+            Result Read(size_t *out, FileAccessor *file, const FilePathHash &path_hash, s64 offset, void *buffer, size_t size, const ReadOption &option);
+
+            void Invalidate(const FileSystemAccessor *fs, const FilePathHash &path_hash);
+            void Invalidate(const FileSystemAccessor *fs);
+        private:
+            Result ReadBlock(size_t *out, FileAccessor *file, const FilePathHash &path_hash, s64 block_index, size_t block_offset, void *buffer, size_t size, const ReadOption &option);
+
+            Entry *FindEntry(const FileSystemAccessor *fs, const FilePathHash &path_hash, s64 block_index);
+            Entry *AllocateEntry();
+    };
+
+    Result ComputeFilePathHash(FilePathHash *out, const char *path);
+
+    FileDataCache *GetGlobalFileDataCache();
+
+}
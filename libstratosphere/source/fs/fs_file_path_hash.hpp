@@ -18,7 +18,8 @@
 
 namespace ams::fs::impl {
 
-    constexpr inline size_t FilePathHashSize = 4;
+    /* NOTE: This is a truncated sha256 of the normalized path, wide enough that distinct files will not collide. */
+    constexpr inline size_t FilePathHashSize = 16;
 
     struct FilePathHash : public Newable {
         u8 data[FilePathHashSize];
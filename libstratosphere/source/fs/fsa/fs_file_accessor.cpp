@@ -16,6 +16,7 @@
 #include <stratosphere.hpp>
 #include "../fs_scoped_setter.hpp"
 #include "../fs_file_path_hash.hpp"
+#include "../fs_file_data_cache.hpp"
 #include "fs_file_accessor.hpp"
 #include "fs_filesystem_accessor.hpp"
 
@@ -39,10 +40,25 @@ namespace ams::fs::impl {
         }
     }
 
+    void FileAccessor::SetFilePathHash(std::unique_ptr<FilePathHash>&& file_path_hash) {
+        m_file_path_hash = std::move(file_path_hash);
+    }
+
     Result FileAccessor::ReadWithCacheAccessLog(size_t *out, s64 offset, void *buf, size_t size, const ReadOption &option, bool use_path_cache, bool use_data_cache) {
-        /* TODO */
-        AMS_UNUSED(out, offset, buf, size, option, use_path_cache, use_data_cache);
-        AMS_ABORT();
+        /* Get a handle to this file for use in logging. */
+        FileHandle handle = { this };
+
+        /* Prefer the mount's own cache, falling back to the global one. */
+        FileDataCache *cache = use_path_cache ? m_parent->GetPathBasedFileDataCache() : nullptr;
+        if (cache == nullptr && use_data_cache) {
+            cache = GetGlobalFileDataCache();
+        }
+
+        if (cache != nullptr) {
+            return AMS_FS_IMPL_ACCESS_LOG_WITH_NAME(cache->Read(out, this, *m_file_path_hash, offset, buf, size, option), handle, "ReadFile", AMS_FS_IMPL_ACCESS_LOG_FORMAT_READ_FILE(out, offset, size));
+        } else {
+            return AMS_FS_IMPL_ACCESS_LOG_WITH_NAME(this->ReadWithoutCacheAccessLog(out, offset, buf, size, option), handle, "ReadFile", AMS_FS_IMPL_ACCESS_LOG_FORMAT_READ_FILE(out, offset, size));
+        }
     }
 
     Result FileAccessor::ReadWithoutCacheAccessLog(size_t *out, s64 offset, void *buf, size_t size, const ReadOption &option) {
@@ -56,12 +72,13 @@ namespace ams::fs::impl {
         /* Fail after a write fails. */
         R_UNLESS(R_SUCCEEDED(m_write_result), AMS_FS_IMPL_ACCESS_LOG_WITH_NAME(m_write_result, handle, "ReadFile", AMS_FS_IMPL_ACCESS_LOG_FORMAT_READ_FILE(out, offset, size)));
 
-        /* TODO: Support cache. */
-        const bool use_path_cache = m_parent != nullptr && m_file_path_hash != nullptr;
-        const bool use_data_cache = /* TODO */false && m_parent != nullptr && m_parent->IsFileDataCacheAttachable();
+        /* Determine whether we can be served from a cache. */
+        /* NOTE: The cache bypasses the file's own read permission check, so we only use it when we may read. */
+        const bool is_cacheable   = m_parent != nullptr && m_file_path_hash != nullptr && (m_open_mode & OpenMode_Read) != 0;
+        const bool use_path_cache = is_cacheable && m_parent->IsPathBasedFileDataCacheAttached();
+        const bool use_data_cache = is_cacheable && m_parent->IsFileDataCacheAttachable() && GetGlobalFileDataCache() != nullptr;
 
-        if (use_path_cache && use_data_cache && false) {
-            /* TODO */
+        if (use_path_cache || use_data_cache) {
             return this->ReadWithCacheAccessLog(out, offset, buf, size, option, use_path_cache, use_data_cache);
         } else {
             return AMS_FS_IMPL_ACCESS_LOG_WITH_NAME(this->ReadWithoutCacheAccessLog(out, offset, buf, size, option), handle, "ReadFile", AMS_FS_IMPL_ACCESS_LOG_FORMAT_READ_FILE(out, offset, size));
@@ -73,10 +90,10 @@ namespace ams::fs::impl {
         R_TRY(m_write_result);
 
         auto setter = MakeScopedSetter(m_write_state, WriteState::Failed);
-        if (m_file_path_hash != nullptr && /* TODO */ false) {
-            /* TODO */
-            AMS_ABORT();
-        } else {
+        {
+            /* Ensure that no stale data remains cached, even if the write partially failed. */
+            ON_SCOPE_EXIT { this->InvalidateFileDataCache(); };
+
             R_TRY(this->UpdateLastResult(m_impl->Write(offset, buf, size, option)));
         }
 
@@ -103,10 +120,10 @@ namespace ams::fs::impl {
         const WriteState old_write_state = m_write_state;
         auto setter = MakeScopedSetter(m_write_state, WriteState::Failed);
 
-        R_TRY(this->UpdateLastResult(m_impl->SetSize(size)));
+        {
+            ON_SCOPE_EXIT { this->InvalidateFileDataCache(); };
 
-        if (m_file_path_hash != nullptr) {
-            /* TODO: invalidate path cache */
+            R_TRY(this->UpdateLastResult(m_impl->SetSize(size)));
         }
 
         setter.Set(old_write_state);
@@ -120,6 +137,12 @@ namespace ams::fs::impl {
         return m_impl->GetSize(out);
     }
 
+    void FileAccessor::InvalidateFileDataCache() {
+        if (m_parent != nullptr) {
+            m_parent->InvalidateFileDataCache(m_file_path_hash.get());
+        }
+    }
+
     Result FileAccessor::OperateRange(void *dst, size_t dst_size, OperationId operation, s64 offset, s64 size, const void *src, size_t src_size) {
         return m_impl->OperateRange(dst, dst_size, operation, offset, size, src, src_size);
     }
@@ -36,7 +36,6 @@ namespace ams::fs::impl {
             Result m_write_result;
             const OpenMode m_open_mode;
             std::unique_ptr<FilePathHash> m_file_path_hash;
-            s32 m_path_hash_index;
         public:
             FileAccessor(std::unique_ptr<fsa::IFile>&& f, FileSystemAccessor *p, OpenMode mode);
             ~FileAccessor();
@@ -52,11 +51,13 @@ namespace ams::fs::impl {
             WriteState GetWriteState() const { return m_write_state; }
             FileSystemAccessor *GetParent() const { return m_parent; }
 
-            void SetFilePathHash(std::unique_ptr<FilePathHash>&& file_path_hash, s32 index);
+            void SetFilePathHash(std::unique_ptr<FilePathHash>&& file_path_hash);
             Result ReadWithoutCacheAccessLog(size_t *out, s64 offset, void *buf, size_t size, const ReadOption &option);
         private:
             Result ReadWithCacheAccessLog(size_t *out, s64 offset, void *buf, size_t size, const ReadOption &option, bool use_path_cache, bool use_data_cache);
 
+            void InvalidateFileDataCache();
+
             ALWAYS_INLINE Result UpdateLastResult(Result r) {
                 if (!fs::ResultNotEnoughFreeSpace::Includes(r)) {
                     m_write_result = r;
@@ -76,9 +76,9 @@ namespace ams::fs::impl {
         if (!m_open_file_list.empty()) { R_ABORT_UNLESS(fs::ResultFileNotClosed()); }
         if (!m_open_dir_list.empty()) { R_ABORT_UNLESS(fs::ResultDirectoryNotClosed()); }
 
-        if (m_path_cache_attached) {
-            /* TODO: Invalidate path cache */
-        }
+        /* Ensure that no cached data outlives us. */
+        this->InvalidateFileDataCache(nullptr);
+        this->DetachPathBasedFileDataCache();
     }
 
     Result FileSystemAccessor::GetCommonMountName(char *dst, size_t dst_size) const {
@@ -94,6 +94,39 @@ namespace ams::fs::impl {
         return nullptr;
     }
 
+    Result FileSystemAccessor::AttachPathBasedFileDataCache(void *buffer, size_t buffer_size) {
+        R_UNLESS(this->IsPathBasedFileDataCacheAttachable(), fs::ResultUnsupportedOperation());
+        R_UNLESS(!m_path_cache_attached,                     fs::ResultPreconditionViolation());
+
+        auto cache = std::make_unique<FileDataCache>();
+        R_UNLESS(cache != nullptr, fs::ResultAllocationFailureInFileSystemAccessorA());
+
+        R_TRY(cache->Initialize(buffer, buffer_size));
+
+        m_path_based_file_data_cache = std::move(cache);
+        m_path_cache_attached        = true;
+        return ResultSuccess();
+    }
+
+    void FileSystemAccessor::DetachPathBasedFileDataCache() {
+        m_path_cache_attached = false;
+        m_path_based_file_data_cache.reset();
+    }
+
+    void FileSystemAccessor::InvalidateFileDataCache(const FilePathHash *path_hash) {
+        /* NOTE: Without a path hash (e.g. for directory operations), we invalidate everything cached for this file system. */
+        FileDataCache *caches[] = { this->GetPathBasedFileDataCache(), m_data_cache_attachable ? GetGlobalFileDataCache() : nullptr };
+        for (auto *cache : caches) {
+            if (cache != nullptr) {
+                if (path_hash != nullptr) {
+                    cache->Invalidate(this, *path_hash);
+                } else {
+                    cache->Invalidate(this);
+                }
+            }
+        }
+    }
+
     void FileSystemAccessor::NotifyCloseFile(FileAccessor *f) {
         std::scoped_lock lk(m_open_list_lock);
         Remove(m_open_file_list, f);
@@ -117,6 +150,7 @@ namespace ams::fs::impl {
 
     Result FileSystemAccessor::DeleteFile(const char *path) {
         R_TRY(ValidatePath(m_name.str, path));
+        ON_SCOPE_EXIT { this->InvalidateFileDataCache(nullptr); };
         return m_impl->DeleteFile(path);
     }
 
@@ -132,31 +166,22 @@ namespace ams::fs::impl {
 
     Result FileSystemAccessor::DeleteDirectoryRecursively(const char *path) {
         R_TRY(ValidatePath(m_name.str, path));
+        ON_SCOPE_EXIT { this->InvalidateFileDataCache(nullptr); };
         return m_impl->DeleteDirectoryRecursively(path);
     }
 
     Result FileSystemAccessor::RenameFile(const char *old_path, const char *new_path) {
         R_TRY(ValidatePath(m_name.str, old_path));
         R_TRY(ValidatePath(m_name.str, new_path));
-        if (m_path_cache_attached) {
-            /* TODO: Path cache */
-            R_TRY(m_impl->RenameFile(old_path, new_path));
-        } else {
-            R_TRY(m_impl->RenameFile(old_path, new_path));
-        }
-        return ResultSuccess();
+        ON_SCOPE_EXIT { this->InvalidateFileDataCache(nullptr); };
+        return m_impl->RenameFile(old_path, new_path);
     }
 
     Result FileSystemAccessor::RenameDirectory(const char *old_path, const char *new_path) {
         R_TRY(ValidatePath(m_name.str, old_path));
         R_TRY(ValidatePath(m_name.str, new_path));
-        if (m_path_cache_attached) {
-            /* TODO: Path cache */
-            R_TRY(m_impl->RenameDirectory(old_path, new_path));
-        } else {
-            R_TRY(m_impl->RenameDirectory(old_path, new_path));
-        }
-        return ResultSuccess();
+        ON_SCOPE_EXIT { this->InvalidateFileDataCache(nullptr); };
+        return m_impl->RenameDirectory(old_path, new_path);
     }
 
     Result FileSystemAccessor::GetEntryType(DirectoryEntryType *out, const char *path) {
@@ -178,11 +203,11 @@ namespace ams::fs::impl {
             m_open_file_list.push_back(*accessor);
         }
 
-        if (m_path_cache_attached) {
-            if (mode & OpenMode_AllowAppend) {
-                /* TODO: Append Path cache */
-            } else {
-                /* TODO: Non-append path cache */
+        /* If the file's data may be cached, note its path hash so that reads can find it. */
+        if (m_data_cache_attachable || m_path_cache_attachable) {
+            auto path_hash = std::make_unique<FilePathHash>();
+            if (path_hash != nullptr && R_SUCCEEDED(ComputeFilePathHash(path_hash.get(), path))) {
+                accessor->SetFilePathHash(std::move(path_hash));
             }
         }
 
@@ -228,6 +253,7 @@ namespace ams::fs::impl {
 
     Result FileSystemAccessor::CleanDirectoryRecursively(const char *path) {
         R_TRY(ValidatePath(m_name.str, path));
+        ON_SCOPE_EXIT { this->InvalidateFileDataCache(nullptr); };
         return m_impl->CleanDirectoryRecursively(path);
     }
 
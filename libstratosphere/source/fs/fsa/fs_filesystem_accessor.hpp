@@ -17,6 +17,7 @@
 #include <stratosphere.hpp>
 #include <stratosphere/fssrv/fssrv_interface_adapters.hpp>
 #include "fs_mount_name.hpp"
+#include "../fs_file_data_cache.hpp"
 
 namespace ams::fs::impl {
 
@@ -42,6 +43,7 @@ namespace ams::fs::impl {
             bool m_path_cache_attachable;
             bool m_path_cache_attached;
             bool m_multi_commit_supported;
+            std::unique_ptr<FileDataCache> m_path_based_file_data_cache;
         public:
             FileSystemAccessor(const char *name, std::unique_ptr<fsa::IFileSystem> &&fs, std::unique_ptr<fsa::ICommonMountNameGenerator> &&generator = nullptr);
             virtual ~FileSystemAccessor();
@@ -75,16 +77,17 @@ namespace ams::fs::impl {
             bool IsFileDataCacheAttachable() const { return m_data_cache_attachable; }
             bool IsPathBasedFileDataCacheAttachable() const { return m_path_cache_attachable; }
 
-            void AttachPathBasedFileDataCache() {
-                if (this->IsPathBasedFileDataCacheAttachable()) {
-                    m_path_cache_attached = true;
-                }
-            }
+            bool IsPathBasedFileDataCacheAttached() const { return m_path_cache_attached; }
+
+            Result AttachPathBasedFileDataCache(void *buffer, size_t buffer_size);
+            void DetachPathBasedFileDataCache();
 
-            void DetachPathBasedFileDataCache() {
-                m_path_cache_attached = false;
+            FileDataCache *GetPathBasedFileDataCache() const {
+                return m_path_cache_attached ? m_path_based_file_data_cache.get() : nullptr;
             }
 
+            void InvalidateFileDataCache(const FilePathHash *path_hash);
+
             std::shared_ptr<fssrv::impl::FileSystemInterfaceAdapter> GetMultiCommitTarget();
 
             fsa::IFileSystem *GetRawFileSystemUnsafe() {
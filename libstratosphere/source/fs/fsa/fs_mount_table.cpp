@@ -24,52 +24,139 @@ namespace ams::fs::impl {
             return std::strncmp(accessor.GetName(), name, sizeof(MountName)) == 0;
         }
 
+        constexpr u32 GetMountNameHash(const char *name) {
+            /* FNV-1a over the mount name. */
+            u32 hash = 0x811C9DC5;
+            for (size_t i = 0; i < sizeof(MountName) && name[i] != '\x00'; ++i) {
+                hash = (hash ^ static_cast<u8>(name[i])) * 0x01000193;
+            }
+            return hash;
+        }
+
+    }
+
+    size_t MountTable::FindIndexSlot(const char *name) const {
+        constexpr size_t Mask = IndexSize - 1;
+
+        /* Probe until we find the name, or reach an empty slot. */
+        const size_t home = GetMountNameHash(name) & Mask;
+        for (size_t i = 0; i < IndexSize; ++i) {
+            const size_t slot = (home + i) & Mask;
+            if (m_index[slot] == nullptr) {
+                break;
+            } else if (MatchesName(*m_index[slot], name)) {
+                return slot;
+            }
+        }
+
+        return InvalidSlot;
+    }
+
+    bool MountTable::InsertIndex(FileSystemAccessor *fs) {
+        constexpr size_t Mask = IndexSize - 1;
+
+        /* Keep the load factor low, so that probe sequences stay short. */
+        if (m_indexed_count >= IndexCountMax) {
+            return false;
+        }
+
+        /* Find the first empty slot in the name's probe sequence. */
+        const size_t home = GetMountNameHash(fs->GetName()) & Mask;
+        for (size_t i = 0; i < IndexSize; ++i) {
+            const size_t slot = (home + i) & Mask;
+            if (m_index[slot] == nullptr) {
+                m_index[slot] = fs;
+                ++m_indexed_count;
+                return true;
+            }
+        }
+
+        AMS_ABORT("MountTable index unexpectedly full");
     }
 
-    bool MountTable::CanAcceptMountName(const char *name) {
-        for (const auto &fs : m_fs_list) {
-            if (MatchesName(fs, name)) {
-                return false;
+    void MountTable::EraseIndex(size_t slot) {
+        constexpr size_t Mask = IndexSize - 1;
+        AMS_ASSERT(slot < IndexSize);
+        AMS_ASSERT(m_index[slot] != nullptr);
+
+        /* Remove the entry with backward-shift deletion, so that we never need tombstones. */
+        size_t hole = slot;
+        for (size_t cur = (slot + 1) & Mask; m_index[cur] != nullptr; cur = (cur + 1) & Mask) {
+            /* An entry may fill the hole if the hole lies between its home slot and its current slot. */
+            const size_t home = GetMountNameHash(m_index[cur]->GetName()) & Mask;
+            if (((cur - home) & Mask) >= ((cur - hole) & Mask)) {
+                m_index[hole] = m_index[cur];
+                hole = cur;
             }
         }
-        return true;
+
+        m_index[hole] = nullptr;
+        --m_indexed_count;
+    }
+
+    FileSystemAccessor *MountTable::FindImpl(const char *name) const {
+        /* Check the index. */
+        if (const size_t slot = this->FindIndexSlot(name); slot != InvalidSlot) {
+            return m_index[slot];
+        }
+
+        /* If some mounts didn't fit in the index, check the list. */
+        if (m_unindexed_count > 0) {
+            for (const auto &fs : m_fs_list) {
+                if (MatchesName(fs, name)) {
+                    return const_cast<FileSystemAccessor *>(std::addressof(fs));
+                }
+            }
+        }
+
+        return nullptr;
     }
 
     Result MountTable::Mount(std::unique_ptr<FileSystemAccessor> &&fs) {
-        std::scoped_lock lk(m_mutex);
+        std::scoped_lock lk(m_lock);
 
-        R_UNLESS(this->CanAcceptMountName(fs->GetName()), fs::ResultMountNameAlreadyExists());
+        R_UNLESS(this->FindImpl(fs->GetName()) == nullptr, fs::ResultMountNameAlreadyExists());
+
+        auto *accessor = fs.release();
+        m_fs_list.push_back(*accessor);
+        if (!this->InsertIndex(accessor)) {
+            ++m_unindexed_count;
+        }
 
-        m_fs_list.push_back(*fs.release());
         return ResultSuccess();
     }
 
     Result MountTable::Find(FileSystemAccessor **out, const char *name) {
-        std::scoped_lock lk(m_mutex);
+        std::shared_lock lk(m_lock);
 
-        for (auto &fs : m_fs_list) {
-            if (MatchesName(fs, name)) {
-                *out = std::addressof(fs);
-                return ResultSuccess();
-            }
-        }
+        auto *accessor = this->FindImpl(name);
+        R_UNLESS(accessor != nullptr, fs::ResultNotMounted());
 
-        return fs::ResultNotMounted();
+        *out = accessor;
+        return ResultSuccess();
     }
 
     void MountTable::Unmount(const char *name) {
-        std::scoped_lock lk(m_mutex);
-
-        for (auto it = m_fs_list.cbegin(); it != m_fs_list.cend(); it++) {
-            if (MatchesName(*it, name)) {
-                auto p = std::addressof(*it);
-                m_fs_list.erase(it);
-                delete p;
-                return;
+        std::scoped_lock lk(m_lock);
+
+        /* Find the accessor, removing it from the index if it's there. */
+        FileSystemAccessor *accessor = nullptr;
+        if (const size_t slot = this->FindIndexSlot(name); slot != InvalidSlot) {
+            accessor = m_index[slot];
+            this->EraseIndex(slot);
+        } else {
+            accessor = this->FindImpl(name);
+            if (accessor != nullptr) {
+                --m_unindexed_count;
             }
         }
 
-        R_ABORT_UNLESS(fs::ResultNotMounted());
+        if (accessor == nullptr) {
+            R_ABORT_UNLESS(fs::ResultNotMounted());
+        }
+
+        m_fs_list.erase(m_fs_list.iterator_to(*accessor));
+        delete accessor;
     }
 
 }
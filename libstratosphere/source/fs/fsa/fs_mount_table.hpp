@@ -24,13 +24,26 @@ namespace ams::fs::impl {
         NON_MOVEABLE(MountTable);
         private:
             using FileSystemList = util::IntrusiveListBaseTraits<FileSystemAccessor>::ListType;
+        private:
+            /* NOTE: Mounts are indexed by an open-addressing hash table; mounts beyond its capacity are only found by scanning the list. */
+            static constexpr size_t IndexSize     = 64;
+            static constexpr size_t IndexCountMax = IndexSize * 3 / 4;
+            static constexpr size_t InvalidSlot   = IndexSize;
+            static_assert(util::IsPowerOfTwo(IndexSize));
         private:
             FileSystemList m_fs_list;
-            os::SdkMutex m_mutex;
+            FileSystemAccessor *m_index[IndexSize];
+            size_t m_indexed_count;
+            size_t m_unindexed_count;
+            os::ReaderWriterLock m_lock;
         public:
-            constexpr MountTable() : m_fs_list(), m_mutex() { /* ... */ }
+            constexpr MountTable() : m_fs_list(), m_index(), m_indexed_count(0), m_unindexed_count(0), m_lock() { /* ... */ }
         private:
-            bool CanAcceptMountName(const char *name);
+            FileSystemAccessor *FindImpl(const char *name) const;
+
+            size_t FindIndexSlot(const char *name) const;
+            bool InsertIndex(FileSystemAccessor *fs);
+            void EraseIndex(size_t slot);
         public:
             Result Mount(std::unique_ptr<FileSystemAccessor> &&fs);
             Result Find(FileSystemAccessor **out, const char *name);
@@ -120,10 +120,7 @@ namespace ams::fs::impl {
         impl::FileSystemAccessor *accessor;
         R_TRY(impl::Find(std::addressof(accessor), name));
 
-        if (accessor->IsFileDataCacheAttachable()) {
-            /* TODO: Data cache purge */
-        }
-
+        /* NOTE: Any cached file data is purged when the accessor is destroyed. */
         impl::Unregister(name);
         return ResultSuccess();
     }
@@ -239,26 +239,46 @@ namespace ams::fssystem {
         return it != m_attr_list.end() ? std::addressof(*it) : nullptr;
     }
 
-    const std::pair<uintptr_t, size_t> FileSystemBufferManager::AllocateBufferImpl(size_t size, const BufferAttribute &attr) {
-        std::scoped_lock lk(m_mutex);
+    std::pair<uintptr_t, size_t> FileSystemBufferManager::AllocateBufferFromHeap(s32 order, size_t size) {
+        AMS_ASSERT(m_mutex.IsLockedByCurrentThread());
 
         std::pair<uintptr_t, size_t> range = {};
+        if (auto address = m_buddy_heap.AllocateByOrder(order); address != 0) {
+            const auto allocated_size = m_buddy_heap.GetBytesFromOrder(order);
+            AMS_ASSERT(size <= allocated_size);
+            AMS_UNUSED(size);
+
+            range.first  = reinterpret_cast<uintptr_t>(address);
+            range.second = allocated_size;
+
+            const size_t free_size = m_buddy_heap.GetTotalFreeSize();
+            m_peak_free_size = std::min(m_peak_free_size, free_size);
+
+            const size_t total_allocatable_size = free_size + m_cache_handle_table.GetTotalCacheSize();
+            m_peak_total_allocatable_size = std::min(m_peak_total_allocatable_size, total_allocatable_size);
+        }
+
+        return range;
+    }
+
+    const std::pair<uintptr_t, size_t> FileSystemBufferManager::AllocateBufferWithoutEviction(size_t size) {
+        std::scoped_lock lk(m_mutex);
+
         const auto order = m_buddy_heap.GetOrderFromBytes(size);
         AMS_ASSERT(order >= 0);
 
-        while (true) {
-            if (auto address = m_buddy_heap.AllocateByOrder(order); address != 0) {
-                const auto allocated_size = m_buddy_heap.GetBytesFromOrder(order);
-                AMS_ASSERT(size <= allocated_size);
+        return this->AllocateBufferFromHeap(order, size);
+    }
 
-                range.first  = reinterpret_cast<uintptr_t>(address);
-                range.second = allocated_size;
+    const std::pair<uintptr_t, size_t> FileSystemBufferManager::AllocateBufferImpl(size_t size, const BufferAttribute &attr) {
+        std::scoped_lock lk(m_mutex);
 
-                const size_t free_size = m_buddy_heap.GetTotalFreeSize();
-                m_peak_free_size = std::min(m_peak_free_size, free_size);
+        std::pair<uintptr_t, size_t> range = {};
+        const auto order = m_buddy_heap.GetOrderFromBytes(size);
+        AMS_ASSERT(order >= 0);
 
-                const size_t total_allocatable_size = free_size + m_cache_handle_table.GetTotalCacheSize();
-                m_peak_total_allocatable_size = std::min(m_peak_total_allocatable_size, total_allocatable_size);
+        while (true) {
+            if (range = this->AllocateBufferFromHeap(order, size); range.first != 0) {
                 break;
             }
 
@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) Atmosphère-NX
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms and conditions of the GNU General Public License,
+ * version 2, as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <stratosphere.hpp>
+
+namespace ams::fssystem {
+
+    /* NOTE: Cache handles are tagged with the index of the manager that published them, so that AcquireCache can */
+    /* be routed without taking any lock other than the owning manager's. */
+
+    namespace {
+
+        constexpr inline IBufferManager::CacheHandle ManagerIndexCount = ShardedFileSystemBufferManager::ShardCountMax + 1;
+
+        constexpr inline IBufferManager::CacheHandle EncodeCacheHandle(IBufferManager::CacheHandle handle, s32 index) {
+            return handle * ManagerIndexCount + index;
+        }
+
+        constexpr inline IBufferManager::CacheHandle DecodeCacheHandle(s32 *out_index, IBufferManager::CacheHandle handle) {
+            *out_index = static_cast<s32>(handle % ManagerIndexCount);
+            return handle / ManagerIndexCount;
+        }
+
+    }
+
+    Result ShardedFileSystemBufferManager::Initialize(s32 shard_count, s32 max_cache_count, uintptr_t address, size_t buffer_size, size_t block_size, size_t shard_size) {
+        /* Validate pre-conditions. */
+        AMS_ASSERT(m_shard_count == 0);
+        AMS_ASSERT(0 < shard_count && shard_count <= ShardCountMax);
+        AMS_ASSERT(max_cache_count > shard_count);
+        AMS_ASSERT(util::IsPowerOfTwo(block_size));
+        AMS_ASSERT(util::IsAligned(shard_size, block_size));
+        AMS_ASSERT(shard_size >= block_size);
+        AMS_ASSERT(shard_size * shard_count < buffer_size);
+
+        /* Give each shard its slice from the start of the heap, and the global manager the remainder. */
+        const size_t global_size = buffer_size - shard_size * shard_count;
+
+        /* Split our cache entries in proportion to the memory each manager holds. */
+        const s32 shard_cache_count = std::max<s32>(1, static_cast<s32>(static_cast<s64>(max_cache_count) * shard_size / buffer_size));
+        AMS_ASSERT(max_cache_count > shard_cache_count * shard_count);
+
+        for (s32 i = 0; i < shard_count; ++i) {
+            R_TRY(m_shards[i].Initialize(shard_cache_count, address + i * shard_size, shard_size, block_size));
+        }
+        R_TRY(m_global.Initialize(max_cache_count - shard_cache_count * shard_count, address + shard_count * shard_size, global_size, block_size));
+
+        /* Set our member variables. */
+        m_shard_count           = shard_count;
+        m_address               = address;
+        m_shard_size            = shard_size;
+        m_shard_buffer_size_max = m_shards[0].GetBufferSizeMax();
+
+        return ResultSuccess();
+    }
+
+    s32 ShardedFileSystemBufferManager::GetHomeShardIndex() const {
+        /* Spread threads across shards by thread id; ids are handed out sequentially, so this distributes evenly. */
+        return static_cast<s32>(os::GetThreadId(os::GetCurrentThread()) % static_cast<u64>(m_shard_count));
+    }
+
+    s32 ShardedFileSystemBufferManager::GetShardIndexFromAddress(uintptr_t address) const {
+        AMS_ASSERT(m_address <= address);
+
+        /* The global manager's memory follows every shard's. */
+        const s32 index = static_cast<s32>((address - m_address) / m_shard_size);
+        return index < m_shard_count ? index : GlobalIndex;
+    }
+
+    const std::pair<uintptr_t, size_t> ShardedFileSystemBufferManager::AllocateBufferImpl(size_t size, const BufferAttribute &attr) {
+        /* Requests too large for a shard can only be served by the global manager. */
+        if (size > m_shard_buffer_size_max) {
+            return m_global.AllocateBuffer(size, attr);
+        }
+
+        /* Take free memory from our home shard, any other shard, or the global manager, before evicting any caches. */
+        const s32 home = this->GetHomeShardIndex();
+        for (s32 i = 0; i < m_shard_count; ++i) {
+            if (const auto range = m_shards[(home + i) % m_shard_count].AllocateBufferWithoutEviction(size); range.first != 0) {
+                return range;
+            }
+        }
+        if (const auto range = m_global.AllocateBufferWithoutEviction(size); range.first != 0) {
+            return range;
+        }
+
+        /* Evict caches from our home shard, and if that isn't enough, from the global manager. */
+        if (const auto range = m_shards[home].AllocateBuffer(size, attr); range.first != 0) {
+            return range;
+        }
+
+        return m_global.AllocateBuffer(size, attr);
+    }
+
+    void ShardedFileSystemBufferManager::DeallocateBufferImpl(uintptr_t address, size_t size) {
+        return this->GetManager(this->GetShardIndexFromAddress(address)).DeallocateBuffer(address, size);
+    }
+
+    ShardedFileSystemBufferManager::CacheHandle ShardedFileSystemBufferManager::RegisterCacheImpl(uintptr_t address, size_t size, const BufferAttribute &attr) {
+        /* Caches are always registered with the manager which owns their memory. */
+        const s32 index = this->GetShardIndexFromAddress(address);
+        return EncodeCacheHandle(this->GetManager(index).RegisterCache(address, size, attr), index);
+    }
+
+    const std::pair<uintptr_t, size_t> ShardedFileSystemBufferManager::AcquireCacheImpl(CacheHandle handle) {
+        s32 index;
+        const CacheHandle manager_handle = DecodeCacheHandle(std::addressof(index), handle);
+        if (index >= m_shard_count && index != GlobalIndex) {
+            return {};
+        }
+
+        return this->GetManager(index).AcquireCache(manager_handle);
+    }
+
+    size_t ShardedFileSystemBufferManager::GetTotalSizeImpl() const {
+        size_t total = m_global.GetTotalSize();
+        for (s32 i = 0; i < m_shard_count; ++i) {
+            total += m_shards[i].GetTotalSize();
+        }
+        return total;
+    }
+
+    size_t ShardedFileSystemBufferManager::GetFreeSizeImpl() const {
+        size_t total = m_global.GetFreeSize();
+        for (s32 i = 0; i < m_shard_count; ++i) {
+            total += m_shards[i].GetFreeSize();
+        }
+        return total;
+    }
+
+    size_t ShardedFileSystemBufferManager::GetTotalAllocatableSizeImpl() const {
+        size_t total = m_global.GetTotalAllocatableSize();
+        for (s32 i = 0; i < m_shard_count; ++i) {
+            total += m_shards[i].GetTotalAllocatableSize();
+        }
+        return total;
+    }
+
+    size_t ShardedFileSystemBufferManager::GetPeakFreeSizeImpl() const {
+        /* NOTE: Managers reach their peaks independently, so this is a lower bound on the true peak. */
+        size_t total = m_global.GetPeakFreeSize();
+        for (s32 i = 0; i < m_shard_count; ++i) {
+            total += m_shards[i].GetPeakFreeSize();
+        }
+        return total;
+    }
+
+    size_t ShardedFileSystemBufferManager::GetPeakTotalAllocatableSizeImpl() const {
+        size_t total = m_global.GetPeakTotalAllocatableSize();
+        for (s32 i = 0; i < m_shard_count; ++i) {
+            total += m_shards[i].GetPeakTotalAllocatableSize();
+        }
+        return total;
+    }
+
+    size_t ShardedFileSystemBufferManager::GetRetriedCountImpl() const {
+        size_t total = m_global.GetRetriedCount();
+        for (s32 i = 0; i < m_shard_count; ++i) {
+            total += m_shards[i].GetRetriedCount();
+        }
+        return total;
+    }
+
+    void ShardedFileSystemBufferManager::ClearPeakImpl() {
+        m_global.ClearPeak();
+        for (s32 i = 0; i < m_shard_count; ++i) {
+            m_shards[i].ClearPeak();
+        }
+    }
+
+}
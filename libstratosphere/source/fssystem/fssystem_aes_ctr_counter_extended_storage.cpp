@@ -148,16 +148,32 @@ namespace ams::fssystem {
             R_UNLESS(cur_entry_offset <= cur_offset, fs::ResultInvalidAesCtrCounterExtendedEntryOffset());
 
             /* Get and validate the next entry offset. */
-            s64 next_entry_offset;
-            if (visitor.CanMoveNext()) {
-                R_TRY(visitor.MoveNext());
-                next_entry_offset = visitor.Get<Entry>()->GetOffset();
-                R_UNLESS(m_table.Includes(next_entry_offset), fs::ResultInvalidAesCtrCounterExtendedEntryOffset());
-            } else {
-                next_entry_offset = m_table.GetEnd();
+            /* NOTE: The counter is derived from the virtual offset, so following entries with the same generation */
+            /* continue our counter stream, and can be decrypted in the same pass. */
+            s64 next_entry_offset = cur_offset;
+            while (true) {
+                const auto prev_entry_offset = next_entry_offset;
+
+                bool can_merge = false;
+                if (visitor.CanMoveNext()) {
+                    R_TRY(visitor.MoveNext());
+
+                    const auto *next_entry = visitor.Get<Entry>();
+                    next_entry_offset = next_entry->GetOffset();
+                    R_UNLESS(m_table.Includes(next_entry_offset), fs::ResultInvalidAesCtrCounterExtendedEntryOffset());
+
+                    can_merge = next_entry->generation == cur_entry.generation;
+                } else {
+                    next_entry_offset = m_table.GetEnd();
+                }
+                R_UNLESS(util::IsAligned(next_entry_offset, BlockSize), fs::ResultInvalidAesCtrCounterExtendedEntryOffset());
+                R_UNLESS(prev_entry_offset < next_entry_offset,         fs::ResultInvalidAesCtrCounterExtendedEntryOffset());
+
+                /* Stop if the next entry needs a different counter, or if we've covered the whole read. */
+                if (!can_merge || end_offset <= next_entry_offset) {
+                    break;
+                }
             }
-            R_UNLESS(util::IsAligned(next_entry_offset, BlockSize), fs::ResultInvalidAesCtrCounterExtendedEntryOffset());
-            R_UNLESS(cur_offset < next_entry_offset,                fs::ResultInvalidAesCtrCounterExtendedEntryOffset());
 
             /* Get the offset of the entry in the data we read. */
             const auto data_offset = cur_offset - cur_entry_offset;
@@ -271,19 +287,32 @@ namespace ams::fssystem {
         size_t remaining_size = buf_size;
         s64 cur_offset = 0;
 
-        /* Allocate a pooled buffer for decryption. */
+        /* If the buffer is device-accessible, we can decrypt it in place without bouncing through a pooled buffer. */
+        /* Either way, bound each call to the decrypt function by the largest pooled buffer we could have used. */
+        const bool is_in_place = IsDeviceAddress(buf);
+
         PooledBuffer pooled_buffer;
-        pooled_buffer.AllocateParticularlyLarge(buf_size, BlockSize);
-        AMS_ASSERT(pooled_buffer.GetSize() > 0 && util::IsAligned(pooled_buffer.GetSize(), BlockSize));
+        size_t chunk_size;
+        if (is_in_place) {
+            chunk_size = util::AlignDown(PooledBuffer::GetAllocatableParticularlyLargeSizeMax(), BlockSize);
+        } else {
+            pooled_buffer.AllocateParticularlyLarge(buf_size, BlockSize);
+            chunk_size = pooled_buffer.GetSize();
+        }
+        AMS_ASSERT(chunk_size > 0 && util::IsAligned(chunk_size, BlockSize));
 
         /* Read and decrypt in chunks. */
         while (remaining_size > 0) {
-            size_t cur_size = std::min(pooled_buffer.GetSize(), remaining_size);
+            size_t cur_size = std::min(chunk_size, remaining_size);
             u8 *dst = static_cast<u8 *>(buf) + cur_offset;
 
-            m_decrypt_function(pooled_buffer.GetBuffer(), cur_size, m_key_index, enc_key, enc_key_size, ctr, IvSize, dst, cur_size);
+            if (is_in_place) {
+                m_decrypt_function(dst, cur_size, m_key_index, enc_key, enc_key_size, ctr, IvSize, dst, cur_size);
+            } else {
+                m_decrypt_function(pooled_buffer.GetBuffer(), cur_size, m_key_index, enc_key, enc_key_size, ctr, IvSize, dst, cur_size);
 
-            std::memcpy(dst, pooled_buffer.GetBuffer(), cur_size);
+                std::memcpy(dst, pooled_buffer.GetBuffer(), cur_size);
+            }
 
             cur_offset     += cur_size;
             remaining_size -= cur_size;
@@ -14,9 +14,115 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <stratosphere.hpp>
+#include "fssystem_aes_round_key_cache.hpp"
 
 namespace ams::fssystem {
 
+    namespace {
+
+        /* Reads at least this large are decrypted in parallel, when a thread pool is available. */
+        constexpr size_t ParallelDecryptionSizeMin = 256_KB;
+        constexpr size_t ParallelChunkSizeMin      = 64_KB;
+
+        /* Reads larger than this are pipelined, overlapping base storage reads with decryption. */
+        constexpr size_t PipelineChunkSize = 512_KB;
+
+        /* Writes are only pipelined when each half of the work buffer is at least this large; otherwise, they're written serially. */
+        constexpr size_t PipelineWriteChunkSizeMin = 16_KB;
+
+        struct ParallelDecryptionContext {
+            char *buffer;
+            size_t size;
+            size_t chunk_size;
+            const crypto::AesEncryptor128 *aes;
+            const char *counter;
+            std::atomic<bool> failed;
+        };
+
+        size_t ProcessCtr(const crypto::AesEncryptor128 *aes, void *dst, size_t dst_size, const void *src, size_t src_size, const void *counter) {
+            /* Use the pre-expanded round keys, rather than re-deriving them for every call. */
+            crypto::CtrDecryptor<crypto::AesEncryptor128> ctr;
+            ctr.Initialize(aes, counter, AesCtrStorage::IvSize);
+
+            return ctr.Update(dst, dst_size, src, src_size);
+        }
+
+        void DecryptChunk(s32 index, void *arg) {
+            auto *ctx = static_cast<ParallelDecryptionContext *>(arg);
+
+            /* Determine the range we're decrypting. */
+            const size_t chunk_offset = ctx->chunk_size * index;
+            const size_t chunk_size   = std::min(ctx->chunk_size, ctx->size - chunk_offset);
+            char *chunk = ctx->buffer + chunk_offset;
+
+            /* Each chunk is independent in CTR mode; we just need to advance the counter to its start. */
+            char ctr[AesCtrStorage::IvSize];
+            std::memcpy(ctr, ctx->counter, sizeof(ctr));
+            AddCounter(ctr, sizeof(ctr), chunk_offset / AesCtrStorage::BlockSize);
+
+            /* Decrypt, noting if we fail to do so correctly. */
+            const auto dec_size = ProcessCtr(ctx->aes, chunk, chunk_size, chunk, chunk_size, ctr);
+            if (dec_size != chunk_size) {
+                ctx->failed = true;
+            }
+        }
+
+        Result DecryptInPlace(ThreadPool *thread_pool, char *buffer, size_t size, const crypto::AesEncryptor128 *aes, const char *counter) {
+            /* If the data is large and we have worker threads, split decryption across them. */
+            if (thread_pool != nullptr && thread_pool->GetThreadCount() > 0 && size >= ParallelDecryptionSizeMin) {
+                const s32 max_chunks    = thread_pool->GetThreadCount() + 1;
+                const size_t chunk_size = std::max(util::AlignUp(util::DivideUp(size, static_cast<size_t>(max_chunks)), AesCtrStorage::BlockSize), ParallelChunkSizeMin);
+
+                ParallelDecryptionContext ctx = { buffer, size, chunk_size, aes, counter, false };
+                thread_pool->ExecuteParallel(DecryptChunk, std::addressof(ctx), static_cast<s32>(util::DivideUp(size, chunk_size)));
+
+                /* Ensure we decrypted correctly. */
+                R_UNLESS(!ctx.failed, fs::ResultUnexpectedInAesCtrStorageA());
+                return ResultSuccess();
+            }
+
+            /* Decrypt, ensure we decrypt correctly. */
+            auto dec_size = ProcessCtr(aes, buffer, size, buffer, size, counter);
+            R_UNLESS(size == dec_size, fs::ResultUnexpectedInAesCtrStorageA());
+
+            return ResultSuccess();
+        }
+
+    }
+
+    class AesCtrStorage::DecryptionCompletion final : public fs::IStorageCompletion, public fs::impl::Newable {
+        NON_COPYABLE(DecryptionCompletion);
+        NON_MOVEABLE(DecryptionCompletion);
+        private:
+            AesCtrStorage *m_storage;
+            s64 m_offset;
+            char *m_buffer;
+            size_t m_size;
+            fs::IStorageCompletion *m_completion;
+        public:
+            DecryptionCompletion(AesCtrStorage *storage, s64 offset, char *buffer, size_t size, fs::IStorageCompletion *completion) : m_storage(storage), m_offset(offset), m_buffer(buffer), m_size(size), m_completion(completion) { /* ... */ }
+
+            virtual void OnCompleted(Result result) override {
+                /* If the read succeeded, decrypt the data in place. */
+                if (R_SUCCEEDED(result)) {
+                    char ctr[IvSize];
+                    std::memcpy(ctr, m_storage->m_iv, IvSize);
+                    AddCounter(ctr, IvSize, m_offset / BlockSize);
+
+                    ScopedAesRoundKeys round_keys(AesRoundKeyCache::Priority::High, m_storage->m_key, nullptr, KeySize);
+
+                    ScopedThreadPriorityChanger cp(+1, ScopedThreadPriorityChanger::Mode::Relative);
+                    result = DecryptInPlace(GetRegisteredThreadPool(), m_buffer, m_size, round_keys.GetEncryptor1(), ctr);
+                }
+
+                /* Release ourselves before notifying, as the caller may destroy the storage in response. */
+                auto * const completion = m_completion;
+                delete this;
+
+                completion->OnCompleted(result);
+            }
+    };
+
     void AesCtrStorage::MakeIv(void *dst, size_t dst_size, u64 upper, s64 offset) {
         /* TODO: util::BytePtr? */
         AMS_ASSERT(dst != nullptr);
@@ -53,22 +159,61 @@ namespace ams::fssystem {
         R_UNLESS(util::IsAligned(offset, BlockSize), fs::ResultInvalidArgument());
         R_UNLESS(util::IsAligned(size, BlockSize),   fs::ResultInvalidArgument());
 
+        /* Setup the counter. */
+        char ctr[IvSize];
+        std::memcpy(ctr, m_iv, IvSize);
+        AddCounter(ctr, IvSize, offset / BlockSize);
+
+        /* Get our round keys. */
+        ScopedAesRoundKeys round_keys(AesRoundKeyCache::Priority::High, m_key, nullptr, KeySize);
+
+        /* If the read is large and we have worker threads, overlap reading each chunk with decrypting the previous one. */
+        auto *thread_pool = GetRegisteredThreadPool();
+        if (thread_pool != nullptr && size > PipelineChunkSize) {
+            char *dst = static_cast<char *>(buffer);
+
+            return ExecutePipelined(thread_pool, static_cast<s32>(util::DivideUp(size, PipelineChunkSize)),
+                [&](s32 index) -> Result {
+                    const size_t chunk_offset = PipelineChunkSize * index;
+                    return m_base_storage->Read(offset + chunk_offset, dst + chunk_offset, std::min(PipelineChunkSize, size - chunk_offset));
+                },
+                [&](s32 index) -> Result {
+                    const size_t chunk_offset = PipelineChunkSize * index;
+
+                    char chunk_ctr[IvSize];
+                    std::memcpy(chunk_ctr, ctr, IvSize);
+                    AddCounter(chunk_ctr, IvSize, chunk_offset / BlockSize);
+
+                    /* Decrypt the data, with temporarily increased priority. */
+                    ScopedThreadPriorityChanger cp(+1, ScopedThreadPriorityChanger::Mode::Relative);
+                    return DecryptInPlace(thread_pool, dst + chunk_offset, std::min(PipelineChunkSize, size - chunk_offset), round_keys.GetEncryptor1(), chunk_ctr);
+                }
+            );
+        }
+
         /* Read the data. */
         R_TRY(m_base_storage->Read(offset, buffer, size));
 
-        /* Prepare to decrypt the data, with temporarily increased priority. */
+        /* Decrypt the data, with temporarily increased priority. */
         ScopedThreadPriorityChanger cp(+1, ScopedThreadPriorityChanger::Mode::Relative);
+        return DecryptInPlace(thread_pool, static_cast<char *>(buffer), size, round_keys.GetEncryptor1(), ctr);
+    }
 
-        /* Setup the counter. */
-        char ctr[IvSize];
-        std::memcpy(ctr, m_iv, IvSize);
-        AddCounter(ctr, IvSize, offset / BlockSize);
+    void AesCtrStorage::ReadAsync(s64 offset, void *buffer, size_t size, fs::IStorageCompletion *completion) {
+        AMS_ASSERT(completion != nullptr);
+
+        /* Reads that Read would finish without touching the base storage complete immediately. */
+        if (size == 0 || buffer == nullptr || !util::IsAligned(offset, BlockSize) || !util::IsAligned(size, BlockSize)) {
+            return completion->OnCompleted(this->Read(offset, buffer, size));
+        }
 
-        /* Decrypt, ensure we decrypt correctly. */
-        auto dec_size = crypto::DecryptAes128Ctr(buffer, size, m_key, KeySize, ctr, IvSize, buffer, size);
-        R_UNLESS(size == dec_size, fs::ResultUnexpectedInAesCtrStorageA());
+        /* Decrypt once our base storage completes the read. If we can't allocate a continuation, fall back to reading synchronously. */
+        auto *decryption = new DecryptionCompletion(this, offset, static_cast<char *>(buffer), size, completion);
+        if (decryption == nullptr) {
+            return completion->OnCompleted(this->Read(offset, buffer, size));
+        }
 
-        return ResultSuccess();
+        return m_base_storage->ReadAsync(offset, buffer, size, decryption);
     }
 
     Result AesCtrStorage::Write(s64 offset, const void *buffer, size_t size) {
@@ -94,6 +239,41 @@ namespace ams::fssystem {
         std::memcpy(ctr, m_iv, IvSize);
         AddCounter(ctr, IvSize, offset / BlockSize);
 
+        /* Get our round keys. */
+        ScopedAesRoundKeys round_keys(AesRoundKeyCache::Priority::High, m_key, nullptr, KeySize);
+
+        /* If we need more than one buffer's worth of writes, overlap encrypting each chunk with writing the previous one. */
+        /* NOTE: We split the buffer we hold into halves, rather than waiting on the pool for a second buffer while holding the first. */
+        const size_t pipeline_chunk_size = util::AlignDown(pooled_buffer.GetSize() / 2, BlockSize);
+        if (auto *thread_pool = GetRegisteredThreadPool(); thread_pool != nullptr && use_work_buffer && size > pooled_buffer.GetSize() && pipeline_chunk_size >= PipelineWriteChunkSizeMin) {
+            char * const work_buffers[2] = { pooled_buffer.GetBuffer(), pooled_buffer.GetBuffer() + pipeline_chunk_size };
+            const size_t chunk_size = pipeline_chunk_size;
+            const char *src = static_cast<const char *>(buffer);
+
+            return ExecutePipelined(thread_pool, static_cast<s32>(util::DivideUp(size, chunk_size)),
+                [&](s32 index) -> Result {
+                    const size_t chunk_offset = chunk_size * index;
+                    const size_t cur_size     = std::min(chunk_size, size - chunk_offset);
+
+                    char chunk_ctr[IvSize];
+                    std::memcpy(chunk_ctr, ctr, IvSize);
+                    AddCounter(chunk_ctr, IvSize, chunk_offset / BlockSize);
+
+                    /* Encrypt the data, with temporarily increased priority. */
+                    ScopedThreadPriorityChanger cp(+1, ScopedThreadPriorityChanger::Mode::Relative);
+
+                    auto enc_size = ProcessCtr(round_keys.GetEncryptor1(), work_buffers[index % 2], cur_size, src + chunk_offset, cur_size, chunk_ctr);
+                    R_UNLESS(enc_size == cur_size, fs::ResultUnexpectedInAesCtrStorageA());
+
+                    return ResultSuccess();
+                },
+                [&](s32 index) -> Result {
+                    const size_t chunk_offset = chunk_size * index;
+                    return m_base_storage->Write(offset + chunk_offset, work_buffers[index % 2], std::min(chunk_size, size - chunk_offset));
+                }
+            );
+        }
+
         /* Loop until all data is written. */
         size_t remaining = size;
         s64 cur_offset = 0;
@@ -106,7 +286,7 @@ namespace ams::fssystem {
             {
                 ScopedThreadPriorityChanger cp(+1, ScopedThreadPriorityChanger::Mode::Relative);
 
-                auto enc_size = crypto::EncryptAes128Ctr(write_buf, write_size, m_key, KeySize, ctr, IvSize, reinterpret_cast<const char *>(buffer) + cur_offset, write_size);
+                auto enc_size = ProcessCtr(round_keys.GetEncryptor1(), write_buf, write_size, reinterpret_cast<const char *>(buffer) + cur_offset, write_size, ctr);
                 R_UNLESS(enc_size == write_size, fs::ResultUnexpectedInAesCtrStorageA());
             }
 
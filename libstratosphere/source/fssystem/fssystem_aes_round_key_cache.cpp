@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) Atmosphère-NX
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms and conditions of the GNU General Public License,
+ * version 2, as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <stratosphere.hpp>
+#include "fssystem_aes_round_key_cache.hpp"
+
+namespace ams::fssystem {
+
+    namespace {
+
+        constexpr inline s32 AesRoundKeyCacheEntryCount = 8;
+
+        constinit os::SdkMutex g_aes_round_key_cache_mutex;
+        constinit std::atomic<bool> g_aes_round_key_cache_initialized = false;
+
+        constinit AesRoundKeyCache g_aes_round_key_cache;
+        util::optional<AesRoundKeyCacheEntry> g_aes_round_key_cache_entry[AesRoundKeyCacheEntryCount];
+
+    }
+
+    AesRoundKeyCache &GetAesRoundKeyCache() {
+        /* Lazily populate the cache, so that storages may be created before any explicit initialization. */
+        if (AMS_UNLIKELY(!g_aes_round_key_cache_initialized.load(std::memory_order_acquire))) {
+            std::scoped_lock lk(g_aes_round_key_cache_mutex);
+
+            if (!g_aes_round_key_cache_initialized.load(std::memory_order_relaxed)) {
+                for (auto &entry : g_aes_round_key_cache_entry) {
+                    entry.emplace();
+                    g_aes_round_key_cache.AddEntry(std::addressof(*entry));
+                }
+
+                g_aes_round_key_cache_initialized.store(true, std::memory_order_release);
+            }
+        }
+
+        return g_aes_round_key_cache;
+    }
+
+}
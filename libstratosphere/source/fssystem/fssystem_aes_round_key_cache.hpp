@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) Atmosphère-NX
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms and conditions of the GNU General Public License,
+ * version 2, as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+#include <stratosphere.hpp>
+
+namespace ams::fssystem {
+
+    class AesRoundKeyCacheEntry : public util::IntrusiveListBaseNode<AesRoundKeyCacheEntry> {
+        NON_COPYABLE(AesRoundKeyCacheEntry);
+        NON_MOVEABLE(AesRoundKeyCacheEntry);
+        public:
+            static constexpr size_t KeySize = crypto::AesEncryptor128::KeySize;
+        private:
+            u8 m_key1[KeySize];
+            u8 m_key2[KeySize];
+            bool m_has_key2;
+            bool m_is_valid;
+            s32 m_reference_count;
+            crypto::AesEncryptor128 m_encryptor1;
+            crypto::AesDecryptor128 m_decryptor1;
+            crypto::AesEncryptor128 m_encryptor2;
+        public:
+            AesRoundKeyCacheEntry() : m_has_key2(false), m_is_valid(false), m_reference_count(0) {
+                std::memset(m_key1, 0, sizeof(m_key1));
+                std::memset(m_key2, 0, sizeof(m_key2));
+            }
+
+            bool Contains(const void *key1, const void *key2, size_t key_size) const {
+                AMS_ASSERT(key_size == KeySize);
+                AMS_UNUSED(key_size);
+
+                if (!m_is_valid || m_has_key2 != (key2 != nullptr)) {
+                    return false;
+                }
+
+                return std::memcmp(m_key1, key1, KeySize) == 0 && (key2 == nullptr || std::memcmp(m_key2, key2, KeySize) == 0);
+            }
+
+            void SetKey(const void *key1, const void *key2, size_t key_size) {
+                AMS_ASSERT(key_size == KeySize);
+                AMS_ASSERT(m_reference_count == 0);
+
+                /* Expand the round keys for the primary key. */
+                std::memcpy(m_key1, key1, key_size);
+                m_encryptor1.Initialize(key1, key_size);
+
+                /* If we have a secondary (tweak) key, expand the round keys needed for xts. */
+                m_has_key2 = key2 != nullptr;
+                if (m_has_key2) {
+                    std::memcpy(m_key2, key2, key_size);
+                    m_decryptor1.Initialize(key1, key_size);
+                    m_encryptor2.Initialize(key2, key_size);
+                }
+
+                m_is_valid = true;
+            }
+
+            bool IsReferenced() const { return m_reference_count > 0; }
+
+            void Open() {
+                ++m_reference_count;
+                AMS_ASSERT(m_reference_count > 0);
+            }
+
+            void Close() {
+                AMS_ASSERT(m_reference_count > 0);
+                --m_reference_count;
+            }
+
+            const crypto::AesEncryptor128 *GetEncryptor1() const { AMS_ASSERT(m_is_valid);   return std::addressof(m_encryptor1); }
+            const crypto::AesDecryptor128 *GetDecryptor1() const { AMS_ASSERT(m_has_key2); return std::addressof(m_decryptor1); }
+            const crypto::AesEncryptor128 *GetEncryptor2() const { AMS_ASSERT(m_has_key2); return std::addressof(m_encryptor2); }
+    };
+
+    class AesRoundKeyCache {
+        NON_COPYABLE(AesRoundKeyCache);
+        NON_MOVEABLE(AesRoundKeyCache);
+        public:
+            enum class Priority {
+                High,
+                Low,
+            };
+        private:
+            using AesRoundKeyCacheEntryList = util::IntrusiveListBaseTraits<AesRoundKeyCacheEntry>::ListType;
+        private:
+            os::SdkMutex m_mutex;
+            AesRoundKeyCacheEntryList m_high_priority_mru_list;
+            AesRoundKeyCacheEntryList m_low_priority_mru_list;
+        public:
+            constexpr AesRoundKeyCache() : m_mutex(), m_high_priority_mru_list(), m_low_priority_mru_list() { /* ... */ }
+
+            /* NOTE: Returned entries are pinned rather than holding the cache lock, so that borrowed round keys may be used concurrently. */
+            /* Entries should only be pinned for the duration of an operation, so that they're shared and recycled (see ScopedAesRoundKeys). */
+            /* When every entry is pinned, nullptr is returned, and the caller should expand its round keys itself. */
+            AesRoundKeyCacheEntry *AllocateHighPriority(const void *key1, const void *key2, size_t key_size) {
+                return this->Allocate(m_high_priority_mru_list, key1, key2, key_size);
+            }
+
+            AesRoundKeyCacheEntry *AllocateLowPriority(const void *key1, const void *key2, size_t key_size) {
+                return this->Allocate(m_low_priority_mru_list, key1, key2, key_size);
+            }
+
+            void Release(AesRoundKeyCacheEntry *entry) {
+                std::scoped_lock lk(m_mutex);
+                entry->Close();
+            }
+
+            void AddEntry(AesRoundKeyCacheEntry *entry) {
+                std::scoped_lock lk(m_mutex);
+                m_low_priority_mru_list.push_front(*entry);
+            }
+        private:
+            AesRoundKeyCacheEntry *Allocate(AesRoundKeyCacheEntryList &dst_list, const void *key1, const void *key2, size_t key_size) {
+                std::scoped_lock lk(m_mutex);
+
+                /* If the round keys are already expanded, borrow them. */
+                AesRoundKeyCacheEntryList *lists[2] = { std::addressof(m_high_priority_mru_list), std::addressof(m_low_priority_mru_list) };
+                for (auto list : lists) {
+                    for (auto it = list->begin(); it != list->end(); ++it) {
+                        if (it->Contains(key1, key2, key_size)) {
+                            return this->OpenEntry(dst_list, *list, it);
+                        }
+                    }
+                }
+
+                /* Otherwise, find the least recently used entry that no one is borrowing, preferring low priority entries. */
+                AesRoundKeyCacheEntryList *src_lists[2] = { std::addressof(m_low_priority_mru_list), std::addressof(m_high_priority_mru_list) };
+                for (auto list : src_lists) {
+                    for (auto it = list->rbegin(); it != list->rend(); ++it) {
+                        if (!it->IsReferenced()) {
+                            it->SetKey(key1, key2, key_size);
+                            return this->OpenEntry(dst_list, *list, std::prev(it.base()));
+                        }
+                    }
+                }
+
+                /* Every entry is in use. */
+                return nullptr;
+            }
+
+            AesRoundKeyCacheEntry *OpenEntry(AesRoundKeyCacheEntryList &dst_list, AesRoundKeyCacheEntryList &src_list, AesRoundKeyCacheEntryList::iterator it) {
+                auto *entry = std::addressof(*it);
+                entry->Open();
+
+                src_list.erase(it);
+                dst_list.push_front(*entry);
+                return entry;
+            }
+    };
+
+    AesRoundKeyCache &GetAesRoundKeyCache();
+
+    /* Round keys for a single operation: borrowed from the cache for the operation's duration when possible, and otherwise expanded just for this operation. */
+    class ScopedAesRoundKeys {
+        NON_COPYABLE(ScopedAesRoundKeys);
+        NON_MOVEABLE(ScopedAesRoundKeys);
+        private:
+            AesRoundKeyCacheEntry *m_cached_entry;
+            util::optional<AesRoundKeyCacheEntry> m_expanded_entry;
+            const AesRoundKeyCacheEntry *m_entry;
+        public:
+            ScopedAesRoundKeys(AesRoundKeyCache::Priority priority, const void *key1, const void *key2, size_t key_size) : m_cached_entry(nullptr), m_expanded_entry(), m_entry(nullptr) {
+                auto &cache = GetAesRoundKeyCache();
+                m_cached_entry = priority == AesRoundKeyCache::Priority::High ? cache.AllocateHighPriority(key1, key2, key_size) : cache.AllocateLowPriority(key1, key2, key_size);
+
+                if (m_cached_entry != nullptr) {
+                    m_entry = m_cached_entry;
+                } else {
+                    m_expanded_entry.emplace();
+                    m_expanded_entry->SetKey(key1, key2, key_size);
+                    m_entry = std::addressof(*m_expanded_entry);
+                }
+            }
+
+            ~ScopedAesRoundKeys() {
+                if (m_cached_entry != nullptr) {
+                    GetAesRoundKeyCache().Release(m_cached_entry);
+                }
+            }
+
+            const crypto::AesEncryptor128 *GetEncryptor1() const { return m_entry->GetEncryptor1(); }
+            const crypto::AesDecryptor128 *GetDecryptor1() const { return m_entry->GetDecryptor1(); }
+            const crypto::AesEncryptor128 *GetEncryptor2() const { return m_entry->GetEncryptor2(); }
+    };
+
+}
@@ -14,9 +14,57 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <stratosphere.hpp>
+#include "fssystem_aes_round_key_cache.hpp"
 
 namespace ams::fssystem {
 
+    namespace {
+
+        /* Accesses larger than this are pipelined, overlapping base storage access with encryption/decryption. */
+        constexpr size_t PipelineChunkSize = 512_KB;
+
+        /* Writes are only pipelined when each half of the work buffer is at least this large; otherwise, they're written serially. */
+        constexpr size_t PipelineWriteChunkSizeMin = 16_KB;
+
+        using XtsDecryptor = crypto::XtsDecryptor<crypto::AesDecryptor128>;
+        using XtsEncryptor = crypto::XtsEncryptor<crypto::AesEncryptor128>;
+
+        template<typename Xts, typename BlockCipher>
+        size_t ProcessSector(void *dst, size_t dst_size, const BlockCipher *cipher1, const crypto::AesEncryptor128 *cipher2, const void *iv, const void *src, size_t src_size) {
+            /* Use the pre-expanded round keys, rather than re-deriving them for every sector. */
+            Xts xts;
+            xts.Initialize(cipher1, cipher2, iv, AesXtsStorage::IvSize);
+
+            u8 *dst_u8 = static_cast<u8 *>(dst);
+            size_t processed = xts.Update(dst_u8, dst_size, src, src_size);
+            processed += xts.Finalize(dst_u8 + processed, dst_size - processed);
+            return processed;
+        }
+
+        template<typename Xts, typename BlockCipher>
+        Result ProcessSectors(char *dst, const char *src, size_t size, const BlockCipher *cipher1, const crypto::AesEncryptor128 *cipher2, const char *counter, size_t block_size) {
+            /* Setup the counter. */
+            char ctr[AesXtsStorage::IvSize];
+            std::memcpy(ctr, counter, sizeof(ctr));
+
+            /* Process each sector, with its own tweak. */
+            while (size > 0) {
+                const size_t cur_size = std::min(block_size, size);
+                const size_t processed_size = ProcessSector<Xts>(dst, cur_size, cipher1, cipher2, ctr, src, cur_size);
+                R_UNLESS(cur_size == processed_size, fs::ResultUnexpectedInAesXtsStorageA());
+
+                AddCounter(ctr, sizeof(ctr), 1);
+
+                dst  += cur_size;
+                src  += cur_size;
+                size -= cur_size;
+            }
+
+            return ResultSuccess();
+        }
+
+    }
+
     AesXtsStorage::AesXtsStorage(IStorage *base, const void *key1, const void *key2, size_t key_size, const void *iv, size_t iv_size, size_t block_size) : m_base_storage(base), m_block_size(block_size), m_mutex() {
         AMS_ASSERT(base != nullptr);
         AMS_ASSERT(key1 != nullptr);
@@ -43,17 +91,46 @@ namespace ams::fssystem {
         R_UNLESS(util::IsAligned(offset, AesBlockSize), fs::ResultInvalidArgument());
         R_UNLESS(util::IsAligned(size,   AesBlockSize), fs::ResultInvalidArgument());
 
+        /* Setup the counter. */
+        char ctr[IvSize];
+        std::memcpy(ctr, m_iv, IvSize);
+        AddCounter(ctr, IvSize, offset / m_block_size);
+
+        /* Get our round keys. */
+        ScopedAesRoundKeys round_keys(AesRoundKeyCache::Priority::Low, m_key[0], m_key[1], KeySize);
+
+        /* If the read is large and sector aligned, overlap reading each chunk with decrypting the previous one. */
+        if (auto *thread_pool = GetRegisteredThreadPool(); thread_pool != nullptr && util::IsAligned(offset, m_block_size) && size > PipelineChunkSize) {
+            const size_t chunk_size = std::max(util::AlignDown(PipelineChunkSize, m_block_size), m_block_size);
+            char *dst = static_cast<char *>(buffer);
+
+            return ExecutePipelined(thread_pool, static_cast<s32>(util::DivideUp(size, chunk_size)),
+                [&](s32 index) -> Result {
+                    const size_t chunk_offset = chunk_size * index;
+                    return m_base_storage->Read(offset + chunk_offset, dst + chunk_offset, std::min(chunk_size, size - chunk_offset));
+                },
+                [&](s32 index) -> Result {
+                    const size_t chunk_offset = chunk_size * index;
+
+                    char chunk_ctr[IvSize];
+                    std::memcpy(chunk_ctr, ctr, IvSize);
+                    AddCounter(chunk_ctr, IvSize, chunk_offset / m_block_size);
+
+                    /* Decrypt the data, with temporarily increased priority. */
+                    ScopedThreadPriorityChanger cp(+1, ScopedThreadPriorityChanger::Mode::Relative);
+
+                    char *cur = dst + chunk_offset;
+                    return ProcessSectors<XtsDecryptor>(cur, cur, std::min(chunk_size, size - chunk_offset), round_keys.GetDecryptor1(), round_keys.GetEncryptor2(), chunk_ctr, m_block_size);
+                }
+            );
+        }
+
         /* Read the data. */
         R_TRY(m_base_storage->Read(offset, buffer, size));
 
         /* Prepare to decrypt the data, with temporarily increased priority. */
         ScopedThreadPriorityChanger cp(+1, ScopedThreadPriorityChanger::Mode::Relative);
 
-        /* Setup the counter. */
-        char ctr[IvSize];
-        std::memcpy(ctr, m_iv, IvSize);
-        AddCounter(ctr, IvSize, offset / m_block_size);
-
         /* Handle any unaligned data before the start. */
         size_t processed_size = 0;
         if ((offset % m_block_size) != 0) {
@@ -69,7 +146,7 @@ namespace ams::fssystem {
                 std::memset(tmp_buf.GetBuffer(), 0, skip_size);
                 std::memcpy(tmp_buf.GetBuffer() + skip_size, buffer, data_size);
 
-                const size_t dec_size = crypto::DecryptAes128Xts(tmp_buf.GetBuffer(), m_block_size, m_key[0], m_key[1], KeySize, ctr, IvSize, tmp_buf.GetBuffer(), m_block_size);
+                const size_t dec_size = ProcessSector<XtsDecryptor>(tmp_buf.GetBuffer(), m_block_size, round_keys.GetDecryptor1(), round_keys.GetEncryptor2(), ctr, tmp_buf.GetBuffer(), m_block_size);
                 R_UNLESS(dec_size == m_block_size, fs::ResultUnexpectedInAesXtsStorageA());
 
                 std::memcpy(buffer, tmp_buf.GetBuffer() + skip_size, data_size);
@@ -82,19 +159,7 @@ namespace ams::fssystem {
 
         /* Decrypt aligned chunks. */
         char *cur = static_cast<char *>(buffer) + processed_size;
-        size_t remaining = size - processed_size;
-        while (remaining > 0) {
-            const size_t cur_size = std::min(m_block_size, remaining);
-            const size_t dec_size = crypto::DecryptAes128Xts(cur, cur_size, m_key[0], m_key[1], KeySize, ctr, IvSize, cur, cur_size);
-            R_UNLESS(cur_size == dec_size, fs::ResultUnexpectedInAesXtsStorageA());
-
-            remaining -= cur_size;
-            cur       += cur_size;
-
-            AddCounter(ctr, IvSize, 1);
-        }
-
-        return ResultSuccess();
+        return ProcessSectors<XtsDecryptor>(cur, cur, size - processed_size, round_keys.GetDecryptor1(), round_keys.GetEncryptor2(), ctr, m_block_size);
     }
 
     Result AesXtsStorage::Write(s64 offset, const void *buffer, size_t size) {
@@ -120,6 +185,36 @@ namespace ams::fssystem {
         std::memcpy(ctr, m_iv, IvSize);
         AddCounter(ctr, IvSize, offset / m_block_size);
 
+        /* Get our round keys. */
+        ScopedAesRoundKeys round_keys(AesRoundKeyCache::Priority::Low, m_key[0], m_key[1], KeySize);
+
+        /* If we need more than one buffer's worth of sector aligned writes, overlap encrypting each chunk with writing the previous one. */
+        /* NOTE: We split the buffer we hold into halves, rather than waiting on the pool for a second buffer while holding the first. */
+        const size_t pipeline_chunk_size = util::AlignDown(pooled_buffer.GetSize() / 2, m_block_size);
+        if (auto *thread_pool = GetRegisteredThreadPool(); thread_pool != nullptr && use_work_buffer && util::IsAligned(offset, m_block_size) && size > pooled_buffer.GetSize() && pipeline_chunk_size >= PipelineWriteChunkSizeMin) {
+            char * const work_buffers[2] = { pooled_buffer.GetBuffer(), pooled_buffer.GetBuffer() + pipeline_chunk_size };
+            const size_t chunk_size = pipeline_chunk_size;
+            const char *src = static_cast<const char *>(buffer);
+
+            return ExecutePipelined(thread_pool, static_cast<s32>(util::DivideUp(size, chunk_size)),
+                [&](s32 index) -> Result {
+                    const size_t chunk_offset = chunk_size * index;
+
+                    char chunk_ctr[IvSize];
+                    std::memcpy(chunk_ctr, ctr, IvSize);
+                    AddCounter(chunk_ctr, IvSize, chunk_offset / m_block_size);
+
+                    /* Encrypt the data, with temporarily increased priority. */
+                    ScopedThreadPriorityChanger cp(+1, ScopedThreadPriorityChanger::Mode::Relative);
+                    return ProcessSectors<XtsEncryptor>(work_buffers[index % 2], src + chunk_offset, std::min(chunk_size, size - chunk_offset), round_keys.GetEncryptor1(), round_keys.GetEncryptor2(), chunk_ctr, m_block_size);
+                },
+                [&](s32 index) -> Result {
+                    const size_t chunk_offset = chunk_size * index;
+                    return m_base_storage->Write(offset + chunk_offset, work_buffers[index % 2], std::min(chunk_size, size - chunk_offset));
+                }
+            );
+        }
+
         /* Handle any unaligned data before the start. */
         size_t processed_size = 0;
         if ((offset % m_block_size) != 0) {
@@ -127,12 +222,6 @@ namespace ams::fssystem {
             const size_t skip_size = static_cast<size_t>(offset - util::AlignDown(offset, m_block_size));
             const size_t data_size = std::min(size, m_block_size - skip_size);
 
-            /* Create an encryptor. */
-            /* NOTE: This is completely unnecessary, because crypto::EncryptAes128Xts is used below. */
-            /* However, Nintendo does it, so we will too. */
-            crypto::Aes128XtsEncryptor xts;
-            xts.Initialize(m_key[0], m_key[1], KeySize, ctr, IvSize);
-
             /* Encrypt into a pooled buffer. */
             {
                 /* NOTE: Nintendo allocates a second pooled buffer here despite having one already allocated above. */
@@ -142,7 +231,7 @@ namespace ams::fssystem {
                 std::memset(tmp_buf.GetBuffer(), 0, skip_size);
                 std::memcpy(tmp_buf.GetBuffer() + skip_size, buffer, data_size);
 
-                const size_t enc_size = crypto::EncryptAes128Xts(tmp_buf.GetBuffer(), m_block_size, m_key[0], m_key[1], KeySize, ctr, IvSize, tmp_buf.GetBuffer(), m_block_size);
+                const size_t enc_size = ProcessSector<XtsEncryptor>(tmp_buf.GetBuffer(), m_block_size, round_keys.GetEncryptor1(), round_keys.GetEncryptor2(), ctr, tmp_buf.GetBuffer(), m_block_size);
                 R_UNLESS(enc_size == m_block_size, fs::ResultUnexpectedInAesXtsStorageA());
 
                 R_TRY(m_base_storage->Write(offset, tmp_buf.GetBuffer() + skip_size, data_size));
@@ -171,7 +260,7 @@ namespace ams::fssystem {
                     const void *src = static_cast<const char *>(buffer) + processed_size + encrypt_offset;
                     void *dst = use_work_buffer ? pooled_buffer.GetBuffer() + encrypt_offset : const_cast<void *>(src);
 
-                    const size_t enc_size = crypto::EncryptAes128Xts(dst, cur_size, m_key[0], m_key[1], KeySize, ctr, IvSize, src, cur_size);
+                    const size_t enc_size = ProcessSector<XtsEncryptor>(dst, cur_size, round_keys.GetEncryptor1(), round_keys.GetEncryptor2(), ctr, src, cur_size);
                     R_UNLESS(enc_size == cur_size, fs::ResultUnexpectedInAesXtsStorageA());
 
                     AddCounter(ctr, IvSize, 1);
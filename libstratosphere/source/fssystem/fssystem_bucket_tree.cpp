@@ -25,6 +25,17 @@ namespace ams::fssystem {
 
         constexpr inline s32 NodeHeaderSize = sizeof(BucketTree::NodeHeader);
 
+        /* Node cache keys are entry set indices for entry sets, and negative for L2 nodes. */
+        constexpr inline s64 InvalidNodeCacheKey = std::numeric_limits<s64>::min();
+
+        constexpr inline s64 GetNodeCacheKeyForNode(s32 node_index) {
+            return -1 - static_cast<s64>(node_index);
+        }
+
+        constexpr inline s64 GetNodeCacheKeyForEntrySet(s32 entry_set_index) {
+            return entry_set_index;
+        }
+
         class StorageNode {
             private:
                 class Offset {
@@ -206,6 +217,8 @@ namespace ams::fssystem {
 
     void BucketTree::Finalize() {
         if (this->IsInitialized()) {
+            this->FinalizeNodeCache();
+
             m_node_storage    = fs::SubStorage();
             m_entry_storage   = fs::SubStorage();
             m_node_l1.Free(m_node_size);
@@ -232,6 +245,9 @@ namespace ams::fssystem {
     }
 
     Result BucketTree::InvalidateCache() {
+        /* Invalidate our own cache of nodes. */
+        this->InvalidateNodeCache();
+
         /* Invalidate the node storage cache. */
         {
             s64 storage_size;
@@ -276,6 +292,107 @@ namespace ams::fssystem {
         return ResultSuccess();
     }
 
+    Result BucketTree::ReadNode(void *dst, s32 node_index) const {
+        return this->ReadNodeWithCache(dst, m_node_storage, (node_index + 1) * static_cast<s64>(m_node_size), GetNodeCacheKeyForNode(node_index));
+    }
+
+    Result BucketTree::ReadEntrySet(void *dst, s32 entry_set_index) const {
+        return this->ReadNodeWithCache(dst, m_entry_storage, entry_set_index * static_cast<s64>(m_node_size), GetNodeCacheKeyForEntrySet(entry_set_index));
+    }
+
+    Result BucketTree::ReadEntrySetPartially(void *dst, s32 entry_set_index, s64 offset, size_t size) const {
+        AMS_ASSERT(0 <= offset && offset + size <= m_node_size);
+
+        /* If the entry set is cached, copy out of the cache. */
+        {
+            std::scoped_lock lk(m_node_cache_mutex);
+
+            const s64 key = GetNodeCacheKeyForEntrySet(entry_set_index);
+            for (auto &entry : m_node_cache) {
+                if (entry.key == key && entry.buffer != nullptr) {
+                    std::memcpy(dst, static_cast<const u8 *>(entry.buffer) + offset, size);
+                    entry.last_used = ++m_node_cache_use_count;
+                    return ResultSuccess();
+                }
+            }
+        }
+
+        /* Otherwise, read just what was asked for; it's not worth pulling in the whole entry set. */
+        return m_entry_storage.Read(entry_set_index * static_cast<s64>(m_node_size) + offset, dst, size);
+    }
+
+    Result BucketTree::ReadNodeWithCache(void *dst, fs::SubStorage &storage, s64 offset, s64 cache_key) const {
+        /* Check whether we have the node cached. */
+        {
+            std::scoped_lock lk(m_node_cache_mutex);
+
+            for (auto &entry : m_node_cache) {
+                if (entry.key == cache_key && entry.buffer != nullptr) {
+                    std::memcpy(dst, entry.buffer, m_node_size);
+                    entry.last_used = ++m_node_cache_use_count;
+                    return ResultSuccess();
+                }
+            }
+        }
+
+        /* Read the node without holding our lock. */
+        R_TRY(storage.Read(offset, dst, m_node_size));
+
+        /* Store the node over the least recently used cache entry. */
+        {
+            std::scoped_lock lk(m_node_cache_mutex);
+
+            NodeCacheEntry *victim = std::addressof(m_node_cache[0]);
+            for (auto &entry : m_node_cache) {
+                /* If someone else cached the node while we were reading it, there's nothing to do. */
+                if (entry.key == cache_key && entry.buffer != nullptr) {
+                    return ResultSuccess();
+                }
+
+                if (entry.last_used < victim->last_used) {
+                    victim = std::addressof(entry);
+                }
+            }
+
+            /* Allocate the cache buffer on first use; if we can't, just don't cache. */
+            if (victim->buffer == nullptr) {
+                victim->buffer = this->GetAllocator()->Allocate(m_node_size, sizeof(s64));
+                R_SUCCEED_IF(victim->buffer == nullptr);
+            }
+
+            std::memcpy(victim->buffer, dst, m_node_size);
+            victim->key       = cache_key;
+            victim->last_used = ++m_node_cache_use_count;
+        }
+
+        return ResultSuccess();
+    }
+
+    void BucketTree::InvalidateNodeCache() const {
+        std::scoped_lock lk(m_node_cache_mutex);
+
+        for (auto &entry : m_node_cache) {
+            entry.key       = InvalidNodeCacheKey;
+            entry.last_used = 0;
+        }
+    }
+
+    void BucketTree::FinalizeNodeCache() {
+        std::scoped_lock lk(m_node_cache_mutex);
+
+        for (auto &entry : m_node_cache) {
+            if (entry.buffer != nullptr) {
+                this->GetAllocator()->Deallocate(entry.buffer, m_node_size);
+            }
+
+            entry.key       = InvalidNodeCacheKey;
+            entry.buffer    = nullptr;
+            entry.last_used = 0;
+        }
+
+        m_node_cache_use_count = 0;
+    }
+
     Result BucketTree::Visitor::Initialize(const BucketTree *tree) {
         AMS_ASSERT(tree != nullptr);
         AMS_ASSERT(m_tree == nullptr || m_tree == tree);
@@ -304,22 +421,21 @@ namespace ams::fssystem {
             const auto end = m_entry_set.info.end;
 
             const auto entry_set_size   = m_tree->m_node_size;
-            const auto entry_set_offset = entry_set_index * static_cast<s64>(entry_set_size);
 
-            R_TRY(m_tree->m_entry_storage.Read(entry_set_offset, std::addressof(m_entry_set), sizeof(EntrySetHeader)));
+            R_TRY(m_tree->ReadEntrySetPartially(std::addressof(m_entry_set), entry_set_index, 0, sizeof(EntrySetHeader)));
             R_TRY(m_entry_set.header.Verify(entry_set_index, entry_set_size, m_tree->m_entry_size));
 
             R_UNLESS(m_entry_set.info.start == end && m_entry_set.info.start < m_entry_set.info.end, fs::ResultInvalidBucketTreeEntrySetOffset());
 
             entry_index = 0;
         } else {
-            m_entry_index = 1;
+            m_entry_index = -1;
         }
 
         /* Read the new entry. */
         const auto entry_size   = m_tree->m_entry_size;
-        const auto entry_offset = impl::GetBucketTreeEntryOffset(m_entry_set.info.index, m_tree->m_node_size, entry_size, entry_index);
-        R_TRY(m_tree->m_entry_storage.Read(entry_offset, std::addressof(m_entry), entry_size));
+        const auto entry_offset = impl::GetBucketTreeEntryOffset(0, entry_size, entry_index);
+        R_TRY(m_tree->ReadEntrySetPartially(m_entry, m_entry_set.info.index, entry_offset, entry_size));
 
         /* Note that we changed index. */
         m_entry_index = entry_index;
@@ -340,9 +456,8 @@ namespace ams::fssystem {
 
             const auto entry_set_size   = m_tree->m_node_size;
             const auto entry_set_index  = m_entry_set.info.index - 1;
-            const auto entry_set_offset = entry_set_index * static_cast<s64>(entry_set_size);
 
-            R_TRY(m_tree->m_entry_storage.Read(entry_set_offset, std::addressof(m_entry_set), sizeof(EntrySetHeader)));
+            R_TRY(m_tree->ReadEntrySetPartially(std::addressof(m_entry_set), entry_set_index, 0, sizeof(EntrySetHeader)));
             R_TRY(m_entry_set.header.Verify(entry_set_index, entry_set_size, m_tree->m_entry_size));
 
             R_UNLESS(m_entry_set.info.end == start && m_entry_set.info.start < m_entry_set.info.end, fs::ResultInvalidBucketTreeEntrySetOffset());
@@ -356,8 +471,8 @@ namespace ams::fssystem {
 
         /* Read the new entry. */
         const auto entry_size   = m_tree->m_entry_size;
-        const auto entry_offset = impl::GetBucketTreeEntryOffset(m_entry_set.info.index, m_tree->m_node_size, entry_size, entry_index);
-        R_TRY(m_tree->m_entry_storage.Read(entry_offset, std::addressof(m_entry), entry_size));
+        const auto entry_offset = impl::GetBucketTreeEntryOffset(0, entry_size, entry_index);
+        R_TRY(m_tree->ReadEntrySetPartially(m_entry, m_entry_set.info.index, entry_offset, entry_size));
 
         /* Note that we changed index. */
         m_entry_index = entry_index;
@@ -426,11 +541,9 @@ namespace ams::fssystem {
     Result BucketTree::Visitor::FindEntrySetWithBuffer(s32 *out_index, s64 virtual_address, s32 node_index, char *buffer) {
         /* Calculate node extents. */
         const auto node_size    = m_tree->m_node_size;
-        const auto node_offset  = (node_index + 1) * static_cast<s64>(node_size);
-        fs::SubStorage &storage = m_tree->m_node_storage;
 
         /* Read the node. */
-        R_TRY(storage.Read(node_offset, buffer, node_size));
+        R_TRY(m_tree->ReadNode(buffer, node_index));
 
         /* Validate the header. */
         NodeHeader header;
@@ -484,11 +597,9 @@ namespace ams::fssystem {
         /* Calculate entry set extents. */
         const auto entry_size       = m_tree->m_entry_size;
         const auto entry_set_size   = m_tree->m_node_size;
-        const auto entry_set_offset = entry_set_index * static_cast<s64>(entry_set_size);
-        fs::SubStorage &storage     = m_tree->m_entry_storage;
 
         /* Read the entry set. */
-        R_TRY(storage.Read(entry_set_offset, buffer, entry_set_size));
+        R_TRY(m_tree->ReadEntrySet(buffer, entry_set_index));
 
         /* Validate the entry_set. */
         EntrySetHeader entry_set;
@@ -31,8 +31,13 @@ namespace ams::fssystem {
         constexpr size_t DeviceBufferSize      = 1_MB;
         constexpr size_t BufferManagerHeapSize = 1_MB;
 
+        constexpr s32    WorkerThreadCount     = 2;
+        constexpr size_t WorkerThreadStackSize = 32_KB;
+
         constexpr size_t MaxCacheCount = 1024;
         constexpr size_t BlockSize     = 16_KB;
+        constexpr s32    ShardCount    = 2;
+        constexpr size_t ShardSize     = 256_KB;
 
         alignas(os::MemoryPageSize) u8 g_exp_heap_buffer[ExpHeapSize];
         lmem::HeapHandle g_exp_heap_handle = nullptr;
@@ -74,9 +79,14 @@ namespace ams::fssystem {
         /* TODO: Nintendo uses os::SetMemoryHeapSize (svc::SetHeapSize) and os::AllocateMemoryBlock for the BufferManager heap. */
         /* It's unclear how we should handle this in ams.mitm (especially hoping to reuse some logic for fs reimpl). */
         /* Should we be doing the same(?) */
-        util::TypedStorage<fssystem::FileSystemBufferManager> g_buffer_manager;
+        util::TypedStorage<fssystem::ShardedFileSystemBufferManager> g_buffer_manager;
         alignas(os::MemoryPageSize) u8 g_buffer_manager_heap[BufferManagerHeapSize];
 
+        /* Worker threads, used to parallelize crypto over large accesses and to read ahead of sequential romfs reads. */
+        /* NOTE: Read-ahead performs full nca reads on these threads, so their stacks must be large enough for that. */
+        alignas(os::ThreadStackAlignment) u8 g_worker_thread_stack[WorkerThreadCount * WorkerThreadStackSize];
+        util::TypedStorage<fssystem::ThreadPool> g_worker_thread_pool;
+
         /* FileSystem creators. */
         util::TypedStorage<fssrv::fscreator::RomFileSystemCreator>       g_rom_fs_creator;
         util::TypedStorage<fssrv::fscreator::PartitionFileSystemCreator> g_partition_fs_creator;
@@ -112,11 +122,15 @@ namespace ams::fssystem {
         /* Initialize the buffer manager. */
         /* TODO FS-REIMPL: os::AllocateMemoryBlock(...); */
         util::ConstructAt(g_buffer_manager);
-        GetReference(g_buffer_manager).Initialize(MaxCacheCount, reinterpret_cast<uintptr_t>(g_buffer_manager_heap), BufferManagerHeapSize, BlockSize);
+        GetReference(g_buffer_manager).Initialize(ShardCount, MaxCacheCount, reinterpret_cast<uintptr_t>(g_buffer_manager_heap), BufferManagerHeapSize, BlockSize, ShardSize);
 
         /* TODO FS-REIMPL: Memory Report Creators, fssrv::SetMemoryReportCreator */
 
-        /* TODO FS-REIMPL: Create Pooled Threads, fssystem::RegisterThreadPool. */
+        /* Create pooled threads. */
+        /* TODO FS-REIMPL: Official FS pooled threads also service access; ours are only used for data-parallel work. */
+        util::ConstructAt(g_worker_thread_pool);
+        R_ABORT_UNLESS(GetReference(g_worker_thread_pool).Initialize(WorkerThreadCount, g_worker_thread_stack, sizeof(g_worker_thread_stack), AMS_GET_SYSTEM_THREAD_PRIORITY(fs, WorkerThreadPool)));
+        fssystem::RegisterThreadPool(GetPointer(g_worker_thread_pool));
 
         /* Initialize fs creators. */
         util::ConstructAt(g_rom_fs_creator, GetPointer(g_allocator));
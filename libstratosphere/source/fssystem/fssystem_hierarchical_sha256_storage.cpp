@@ -31,8 +31,23 @@ namespace ams::fssystem {
             return log;
         }
 
+        /* Reads at least this large have their blocks hashed in parallel, when a thread pool is available. */
+        constexpr size_t ParallelVerificationSizeMin = 256_KB;
+
+        /* Blocks are hashed together in batches of up to this many. */
+        constexpr size_t VerificationBatchCount = 8;
+
     }
 
+    struct HierarchicalSha256Storage::ParallelVerificationContext {
+        HierarchicalSha256Storage *storage;
+        const u8 *buffer;
+        s64 offset;
+        size_t size;
+        size_t chunk_size;
+        std::atomic<bool> failed;
+    };
+
     Result HierarchicalSha256Storage::Initialize(IStorage **base_storages, s32 layer_count, size_t htbs, void *hash_buf, size_t hash_buf_size) {
         /* Validate preconditions. */
         AMS_ASSERT(layer_count == LayerCount);
@@ -96,35 +111,87 @@ namespace ams::fssystem {
         /* Temporarily increase our thread priority. */
         ScopedThreadPriorityChanger cp(+1, ScopedThreadPriorityChanger::Mode::Relative);
 
-        /* Setup tracking variables. */
-        auto cur_offset     = offset;
-        auto remaining_size = reduced_size;
-        while (remaining_size > 0) {
-            /* Generate the hash of the region we're validating. */
-            u8 hash[HashSize];
-            const auto cur_size = static_cast<size_t>(std::min<s64>(m_hash_target_block_size, remaining_size));
-            crypto::GenerateSha256Hash(hash, sizeof(hash), static_cast<u8 *>(buffer) + (cur_offset - offset), cur_size);
+        /* If we fail to verify, don't leave any unverified data in the output buffer. */
+        auto clear_guard = SCOPE_GUARD { std::memset(buffer, 0, size); };
+
+        /* If the read is large and we have worker threads, verify in parallel. */
+        if (auto *thread_pool = GetRegisteredThreadPool(); thread_pool != nullptr && thread_pool->GetThreadCount() > 0 && reduced_size >= ParallelVerificationSizeMin) {
+            const size_t max_chunks = static_cast<size_t>(thread_pool->GetThreadCount() + 1);
+            const size_t chunk_size = util::AlignUp(util::DivideUp(reduced_size, max_chunks), m_hash_target_block_size);
+
+            ParallelVerificationContext ctx = { this, static_cast<const u8 *>(buffer), offset, reduced_size, chunk_size, false };
+            thread_pool->ExecuteParallel(VerifyBlocksParallel, std::addressof(ctx), static_cast<s32>(util::DivideUp(reduced_size, chunk_size)));
+
+            R_UNLESS(!ctx.failed, fs::ResultHierarchicalSha256HashVerificationFailed());
+        } else {
+            R_TRY(this->VerifyBlocks(offset, static_cast<const u8 *>(buffer), reduced_size));
+        }
 
-            AMS_ASSERT(static_cast<size_t>(cur_offset >> m_log_size_ratio) < m_hash_buffer_size);
+        clear_guard.Cancel();
+        return ResultSuccess();
+    }
+
+    Result HierarchicalSha256Storage::VerifyBlocks(s64 offset, const u8 *data, size_t size) {
+        AMS_ASSERT(util::IsAligned(offset, m_hash_target_block_size));
+
+        const size_t block_size = static_cast<size_t>(m_hash_target_block_size);
+
+        size_t processed = 0;
+        while (processed < size) {
+            /* Gather a batch of blocks. */
+            /* NOTE: Only full blocks are batched, as every buffer hashed together must be the same size. */
+            const void *batch_data[VerificationBatchCount];
+            s64 batch_offsets[VerificationBatchCount];
+            size_t batch_count = 0;
+            size_t batch_size  = 0;
+            while (processed < size && batch_count < VerificationBatchCount) {
+                const size_t cur_size = std::min(block_size, size - processed);
+
+                /* A partial block can't join a batch of full ones; leave it for the next batch. */
+                if (batch_count > 0 && cur_size != batch_size) {
+                    break;
+                }
+
+                batch_data[batch_count]    = data + processed;
+                batch_offsets[batch_count] = offset + processed;
+                batch_size                 = cur_size;
+                ++batch_count;
+
+                processed += cur_size;
+            }
 
-            /* Check the hash. */
+            /* Generate the hashes of the blocks we're validating. */
+            u8 hashes[VerificationBatchCount][HashSize];
+            crypto::GenerateSha256HashMulti(hashes, sizeof(hashes), batch_data, batch_count, batch_size);
+
+            /* Check the hashes. */
             {
                 std::scoped_lock lk(m_mutex);
-                auto clear_guard = SCOPE_GUARD { std::memset(buffer, 0, size); };
 
-                R_UNLESS(crypto::IsSameBytes(hash, std::addressof(m_hash_buffer[cur_offset >> m_log_size_ratio]), HashSize), fs::ResultHierarchicalSha256HashVerificationFailed());
+                for (size_t i = 0; i < batch_count; ++i) {
+                    AMS_ASSERT(static_cast<size_t>(batch_offsets[i] >> m_log_size_ratio) < m_hash_buffer_size);
 
-                clear_guard.Cancel();
+                    R_UNLESS(crypto::IsSameBytes(hashes[i], std::addressof(m_hash_buffer[batch_offsets[i] >> m_log_size_ratio]), HashSize), fs::ResultHierarchicalSha256HashVerificationFailed());
+                }
             }
-
-            /* Advance. */
-            cur_offset     += cur_size;
-            remaining_size -= cur_size;
         }
 
         return ResultSuccess();
     }
 
+    void HierarchicalSha256Storage::VerifyBlocksParallel(s32 index, void *arg) {
+        auto *ctx = static_cast<ParallelVerificationContext *>(arg);
+
+        /* Determine the range we're verifying. */
+        const size_t chunk_offset = ctx->chunk_size * index;
+        const size_t chunk_size   = std::min(ctx->chunk_size, ctx->size - chunk_offset);
+
+        /* Verify the blocks in the range. */
+        if (R_FAILED(ctx->storage->VerifyBlocks(ctx->offset + chunk_offset, ctx->buffer + chunk_offset, chunk_size))) {
+            ctx->failed = true;
+        }
+    }
+
     Result HierarchicalSha256Storage::Write(s64 offset, const void *buffer, size_t size) {
         /* Succeed if zero-size. */
         R_SUCCEED_IF(size == 0);
@@ -24,6 +24,8 @@ namespace ams::fssystem {
         public:
             static constexpr s32 LayerCount  = 3;
             static constexpr size_t HashSize = crypto::Sha256Generator::HashSize;
+        private:
+            struct ParallelVerificationContext;
         private:
             os::SdkMutex m_mutex;
             IStorage *m_base_storage;
@@ -53,6 +55,10 @@ namespace ams::fssystem {
                 AMS_UNUSED(size);
                 return fs::ResultUnsupportedOperationInHierarchicalSha256StorageA();
             }
+        private:
+            Result VerifyBlocks(s64 offset, const u8 *data, size_t size);
+
+            static void VerifyBlocksParallel(s32 index, void *arg);
     };
 
 }
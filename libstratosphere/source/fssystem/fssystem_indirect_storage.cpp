@@ -17,6 +17,50 @@
 
 namespace ams::fssystem {
 
+    namespace {
+
+        /* Completes a read once the reads issued for each of its entries have all completed. */
+        class PerEntryReadCompletion final : public fs::IStorageCompletion, public fs::impl::Newable {
+            NON_COPYABLE(PerEntryReadCompletion);
+            NON_MOVEABLE(PerEntryReadCompletion);
+            private:
+                os::SdkMutex m_mutex;
+                fs::IStorageCompletion *m_completion;
+                Result m_result;
+                s32 m_pending_count;
+            public:
+                explicit PerEntryReadCompletion(fs::IStorageCompletion *completion) : m_mutex(), m_completion(completion), m_result(ResultSuccess()), m_pending_count(1) { /* ... */ }
+
+                void AddPending() {
+                    std::scoped_lock lk(m_mutex);
+                    ++m_pending_count;
+                }
+
+                virtual void OnCompleted(Result result) override {
+                    {
+                        std::scoped_lock lk(m_mutex);
+
+                        /* Keep the first failure. */
+                        if (R_FAILED(result) && R_SUCCEEDED(m_result)) {
+                            m_result = result;
+                        }
+
+                        if ((--m_pending_count) > 0) {
+                            return;
+                        }
+                    }
+
+                    /* Release ourselves before notifying, as the caller may destroy the storage in response. */
+                    const Result final_result = m_result;
+                    auto * const completion   = m_completion;
+                    delete this;
+
+                    completion->OnCompleted(final_result);
+                }
+        };
+
+    }
+
     Result IndirectStorage::Initialize(IAllocator *allocator, fs::SubStorage table_storage) {
         /* Read and verify the bucket tree header. */
         BucketTree::Header header;
@@ -110,6 +154,8 @@ namespace ams::fssystem {
         /* Ensure that we have a buffer to read to. */
         R_UNLESS(buffer != nullptr, fs::ResultNullptrArgument());
 
+        /* NOTE: Each entry is read straight into the caller's buffer. The only pooled buffers involved hold bucket tree nodes while */
+        /* scanning for continuous reads, and they are needed whatever buffer the caller passes, so there is no bounce to bypass here. */
         R_TRY(this->OperatePerEntry<true>(offset, size, [=](fs::IStorage *storage, s64 data_offset, s64 cur_offset, s64 cur_size) -> Result {
             R_TRY(storage->Read(data_offset, reinterpret_cast<u8 *>(buffer) + (cur_offset - offset), static_cast<size_t>(cur_size)));
             return ResultSuccess();
@@ -118,6 +164,35 @@ namespace ams::fssystem {
         return ResultSuccess();
     }
 
+    void IndirectStorage::ReadAsync(s64 offset, void *buffer, size_t size, fs::IStorageCompletion *completion) {
+        /* Validate pre-conditions. */
+        AMS_ASSERT(offset >= 0);
+        AMS_ASSERT(this->IsInitialized());
+        AMS_ASSERT(completion != nullptr);
+
+        /* Reads that Read would finish without touching a data storage complete immediately. */
+        if (size == 0 || buffer == nullptr) {
+            return completion->OnCompleted(this->Read(offset, buffer, size));
+        }
+
+        /* Allocate a completion to join our per-entry reads. If we can't, fall back to reading synchronously. */
+        auto *join = new PerEntryReadCompletion(completion);
+        if (join == nullptr) {
+            return completion->OnCompleted(this->Read(offset, buffer, size));
+        }
+
+        /* Issue a read for each entry. */
+        /* NOTE: Continuous reading isn't used here, as a merged read would race with the reads of the fragments it covers. */
+        const Result result = this->OperatePerEntry<false>(offset, size, [=](fs::IStorage *storage, s64 data_offset, s64 cur_offset, s64 cur_size) -> Result {
+            join->AddPending();
+            storage->ReadAsync(data_offset, reinterpret_cast<u8 *>(buffer) + (cur_offset - offset), static_cast<size_t>(cur_size), join);
+            return ResultSuccess();
+        });
+
+        /* Release our own reference; whichever completion is last notifies the caller. */
+        join->OnCompleted(result);
+    }
+
     Result IndirectStorage::OperateRange(void *dst, size_t dst_size, fs::OperationId op_id, s64 offset, s64 size, const void *src, size_t src_size) {
         switch (op_id) {
             case fs::OperationId::Invalidate:
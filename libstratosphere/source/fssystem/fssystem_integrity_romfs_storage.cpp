@@ -35,7 +35,11 @@ namespace ams::fssystem {
         }
 
         /* Initialize our integrity storage. */
-        return m_integrity_storage.Initialize(level_hash_info, storage_info, std::addressof(m_buffers), std::addressof(m_mutex), fs::StorageType_RomFs);
+        R_TRY(m_integrity_storage.Initialize(level_hash_info, storage_info, std::addressof(m_buffers), std::addressof(m_mutex), fs::StorageType_RomFs));
+
+        /* RomFs is read-only, so moving cache entries between levels never needs to write anything back. */
+        m_integrity_storage.SetAdaptiveCacheSizingEnabled(true);
+        return ResultSuccess();
     }
 
     void IntegrityRomFsStorage::Finalize() {
@@ -886,6 +886,9 @@ namespace ams::fssystem {
         /* Initialize the indirect data storage. */
         R_TRY(indirect_data_storage->Initialize(fs::SubStorage(base_storage.get(), 0, indirect_data_size), m_buffer_manager, IndirectDataCacheBlockSize, IndirectDataCacheCount));
 
+        /* Patch data is read-only and often streamed, so prefetch ahead of sequential reads. */
+        indirect_data_storage->EnableReadAhead();
+
         /* Create the storage holder. */
         std::unique_ptr storage = std::make_unique<DerivedStorageHolder<IndirectStorage, 4>>(m_reader);
         R_UNLESS(storage != nullptr, fs::ResultAllocationFailureInNew());
@@ -38,16 +38,20 @@ namespace ams::fssystem {
         AMS_ASSERT(allocator != nullptr);
 
         /* Determine the meta data size. */
-        R_TRY(this->QueryMetaDataSize(std::addressof(m_meta_data_size), storage));
+        s32 entry_count;
+        R_TRY(this->QueryMetaDataSize(std::addressof(m_meta_data_size), std::addressof(entry_count), storage));
 
         /* Deallocate any old meta buffer and allocate a new one. */
         this->DeallocateBuffer();
         m_allocator = allocator;
-        m_buffer = static_cast<char *>(m_allocator->Allocate(m_meta_data_size));
-        R_UNLESS(m_buffer != nullptr, fs::ResultAllocationFailureInPartitionFileSystemMetaA());
+        R_UNLESS(this->AllocateBuffer(entry_count), fs::ResultAllocationFailureInPartitionFileSystemMetaA());
 
         /* Perform regular initialization. */
-        return this->Initialize(storage, m_buffer, m_meta_data_size);
+        R_TRY(this->Initialize(storage, m_buffer, m_meta_data_size));
+
+        /* Build our name index. */
+        this->BuildNameIndex();
+        return ResultSuccess();
     }
 
     template <typename Format>
@@ -55,6 +59,9 @@ namespace ams::fssystem {
         /* Validate size for header. */
         R_UNLESS(meta_size >= sizeof(PartitionFileSystemHeader), fs::ResultInvalidSize());
 
+        /* A caller-provided buffer has no room for a name index. */
+        m_name_index = nullptr;
+
         /* Read the header. */
         R_TRY(storage->Read(0, meta, sizeof(PartitionFileSystemHeader)));
 
@@ -78,13 +85,78 @@ namespace ams::fssystem {
         return ResultSuccess();
     }
 
+    template <typename Format>
+    bool PartitionFileSystemMetaCore<Format>::AllocateBuffer(s32 entry_count) {
+        AMS_ASSERT(m_allocator != nullptr);
+        AMS_ASSERT(m_buffer == nullptr);
+
+        /* Try to allocate room for the name index after the meta data. */
+        if (entry_count > 0) {
+            const size_t buffer_size = util::AlignUp(m_meta_data_size, alignof(s32)) + entry_count * sizeof(s32);
+            if (char *buffer = static_cast<char *>(m_allocator->Allocate(buffer_size)); buffer != nullptr) {
+                m_buffer      = buffer;
+                m_buffer_size = buffer_size;
+                return true;
+            }
+        }
+
+        /* Otherwise, allocate only the meta data; lookups will scan the entries. */
+        m_buffer = static_cast<char *>(m_allocator->Allocate(m_meta_data_size));
+        if (m_buffer == nullptr) {
+            return false;
+        }
+
+        m_buffer_size = m_meta_data_size;
+        return true;
+    }
+
     template <typename Format>
     void PartitionFileSystemMetaCore<Format>::DeallocateBuffer() {
         if (m_buffer != nullptr) {
             AMS_ABORT_UNLESS(m_allocator != nullptr);
-            m_allocator->Deallocate(m_buffer, m_meta_data_size);
-            m_buffer = nullptr;
+            m_allocator->Deallocate(m_buffer, m_buffer_size);
+            m_buffer      = nullptr;
+            m_buffer_size = 0;
+            m_name_index  = nullptr;
+        }
+    }
+
+    template <typename Format>
+    void PartitionFileSystemMetaCore<Format>::BuildNameIndex() {
+        AMS_ASSERT(m_initialized);
+
+        /* Determine where the index lives, and check that we allocated room for it. */
+        m_name_index = nullptr;
+
+        const s32 entry_count = m_header->entry_count;
+        const size_t index_offset = util::AlignUp(m_meta_data_size, alignof(s32));
+        if (entry_count <= 0 || m_buffer == nullptr || m_buffer_size < index_offset + entry_count * sizeof(s32)) {
+            return;
+        }
+
+        /* Only index well-formed name tables, so that lookups match the linear scan exactly. */
+        for (s32 i = 0; i < entry_count; ++i) {
+            const auto name_offset = m_entries[i].name_offset;
+            if (name_offset >= m_header->name_table_size) {
+                return;
+            }
+            if (strnlen(m_name_table + name_offset, m_header->name_table_size - name_offset) == m_header->name_table_size - name_offset) {
+                return;
+            }
+        }
+
+        /* Sort entry indices by name. Ties are ordered by index, so that the first of any duplicate names is found. */
+        s32 *index = reinterpret_cast<s32 *>(m_buffer + index_offset);
+        for (s32 i = 0; i < entry_count; ++i) {
+            index[i] = i;
         }
+
+        std::sort(index, index + entry_count, [this](s32 lhs, s32 rhs) {
+            const int cmp = std::strcmp(m_name_table + m_entries[lhs].name_offset, m_name_table + m_entries[rhs].name_offset);
+            return cmp < 0 || (cmp == 0 && lhs < rhs);
+        });
+
+        m_name_index = index;
     }
 
     template <typename Format>
@@ -110,6 +182,33 @@ namespace ams::fssystem {
             return 0;
         }
 
+        /* If we don't have a name index, scan the entries. */
+        if (m_name_index == nullptr) {
+            return this->GetEntryIndexLinear(name);
+        }
+
+        /* Find the first entry whose name is not less than the input name. */
+        s32 lo = 0, hi = m_header->entry_count;
+        while (lo < hi) {
+            const s32 mid = lo + (hi - lo) / 2;
+            if (std::strcmp(m_name_table + m_entries[m_name_index[mid]].name_offset, name) < 0) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+
+        /* Check whether we found the name. */
+        if (lo < static_cast<s32>(m_header->entry_count) && std::strcmp(m_name_table + m_entries[m_name_index[lo]].name_offset, name) == 0) {
+            return m_name_index[lo];
+        }
+
+        /* Not found. */
+        return -1;
+    }
+
+    template <typename Format>
+    s32 PartitionFileSystemMetaCore<Format>::GetEntryIndexLinear(const char *name) const {
         for (s32 i = 0; i < static_cast<s32>(m_header->entry_count); i++) {
             const auto &entry = m_entries[i];
 
@@ -149,13 +248,20 @@ namespace ams::fssystem {
 
     template <typename Format>
     Result PartitionFileSystemMetaCore<Format>::QueryMetaDataSize(size_t *out_size, fs::IStorage *storage) {
+        s32 dummy_entry_count;
+        return QueryMetaDataSize(out_size, std::addressof(dummy_entry_count), storage);
+    }
+
+    template <typename Format>
+    Result PartitionFileSystemMetaCore<Format>::QueryMetaDataSize(size_t *out_size, s32 *out_entry_count, fs::IStorage *storage) {
         /* Read and validate the header. */
         PartitionFileSystemHeader header;
         R_TRY(storage->Read(0, std::addressof(header), sizeof(PartitionFileSystemHeader)));
         R_UNLESS(crypto::IsSameBytes(std::addressof(header), Format::VersionSignature, sizeof(Format::VersionSignature)), typename Format::ResultSignatureVerificationFailed());
 
         /* Output size. */
-        *out_size = sizeof(PartitionFileSystemHeader) + header.entry_count * sizeof(typename Format::PartitionEntry) + header.name_table_size;
+        *out_size        = sizeof(PartitionFileSystemHeader) + header.entry_count * sizeof(typename Format::PartitionEntry) + header.name_table_size;
+        *out_entry_count = header.entry_count;
         return ResultSuccess();
     }
 
@@ -167,15 +273,15 @@ namespace ams::fssystem {
         R_UNLESS(hash_size == crypto::Sha256Generator::HashSize, fs::ResultPreconditionViolation());
 
         /* Get metadata size. */
-        R_TRY(QueryMetaDataSize(std::addressof(m_meta_data_size), base_storage));
+        s32 entry_count;
+        R_TRY(QueryMetaDataSize(std::addressof(m_meta_data_size), std::addressof(entry_count), base_storage));
 
         /* Ensure we have no buffer. */
         this->DeallocateBuffer();
 
         /* Set allocator and allocate buffer. */
         m_allocator = allocator;
-        m_buffer = static_cast<char *>(m_allocator->Allocate(m_meta_data_size));
-        R_UNLESS(m_buffer != nullptr, fs::ResultAllocationFailureInPartitionFileSystemMetaB());
+        R_UNLESS(this->AllocateBuffer(entry_count), fs::ResultAllocationFailureInPartitionFileSystemMetaB());
 
         /* Read metadata. */
         R_TRY(base_storage->Read(0, m_buffer, m_meta_data_size));
@@ -213,6 +319,9 @@ namespace ams::fssystem {
 
         /* We initialized. */
         m_initialized = true;
+
+        /* Build our name index. */
+        this->BuildNameIndex();
         return ResultSuccess();
     }
 
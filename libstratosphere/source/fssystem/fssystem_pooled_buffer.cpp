@@ -88,6 +88,152 @@ namespace ams::fssystem {
 
         constinit AdditionalDeviceAddressEntry g_additional_device_address_entry;
 
+        /* Buffers of commonly requested sizes are cached in small per-core magazines, so that */
+        /* threads running on different cores don't serialize on the heap mutex. */
+        constexpr s32 MagazineShardCount  = 4;
+        constexpr s32 MagazineCapacityMax = 2;
+
+        struct MagazineClass {
+            size_t size;
+            s32 capacity;
+        };
+
+        constexpr const MagazineClass MagazineClasses[] = {
+            {  16_KB, 2 },
+            { 128_KB, 2 },
+            { 512_KB, 1 },
+        };
+        constexpr s32 MagazineClassCount = static_cast<s32>(util::size(MagazineClasses));
+
+        static_assert(MagazineClasses[MagazineClassCount - 1].size <= HeapAllocatableSizeMax);
+        static_assert([] {
+            for (const auto &magazine_class : MagazineClasses) {
+                if (magazine_class.capacity > MagazineCapacityMax) {
+                    return false;
+                }
+            }
+            return true;
+        }());
+
+        /* Don't let the magazines hold more than an eighth of the heap. */
+        constexpr size_t MagazineCachedSizeDivisor = 8;
+
+        constinit std::atomic<size_t> g_magazine_cached_size;
+        constinit std::atomic<size_t> g_magazine_cached_size_peak;
+        constinit std::atomic<size_t> g_magazine_hit_count;
+        constinit std::atomic<size_t> g_magazine_fallback_count;
+
+        class BufferMagazine {
+            private:
+                os::SdkMutex m_mutex;
+                char *m_buffers[MagazineClassCount][MagazineCapacityMax];
+                s32 m_counts[MagazineClassCount];
+            public:
+                constexpr BufferMagazine() : m_mutex(), m_buffers(), m_counts() { /* ... */ }
+
+                char *Pop(s32 class_index) {
+                    AMS_ASSERT(0 <= class_index && class_index < MagazineClassCount);
+
+                    std::scoped_lock lk(m_mutex);
+
+                    if (m_counts[class_index] == 0) {
+                        return nullptr;
+                    }
+
+                    g_magazine_cached_size -= MagazineClasses[class_index].size;
+                    return m_buffers[class_index][--m_counts[class_index]];
+                }
+
+                bool Push(s32 class_index, char *buffer) {
+                    AMS_ASSERT(0 <= class_index && class_index < MagazineClassCount);
+                    AMS_ASSERT(buffer != nullptr);
+
+                    std::scoped_lock lk(m_mutex);
+
+                    if (m_counts[class_index] >= MagazineClasses[class_index].capacity) {
+                        return false;
+                    }
+
+                    /* Reserve space against the global limit. */
+                    const size_t size        = MagazineClasses[class_index].size;
+                    const size_t cached_size = (g_magazine_cached_size += size);
+                    if (cached_size > g_heap_size / MagazineCachedSizeDivisor) {
+                        g_magazine_cached_size -= size;
+                        return false;
+                    }
+
+                    /* Update the peak. */
+                    size_t peak = g_magazine_cached_size_peak.load();
+                    while (peak < cached_size && !g_magazine_cached_size_peak.compare_exchange_weak(peak, cached_size)) {
+                        /* ... */
+                    }
+
+                    m_buffers[class_index][m_counts[class_index]++] = buffer;
+                    return true;
+                }
+
+                bool Drain() {
+                    std::scoped_lock lk(m_mutex);
+
+                    bool drained = false;
+                    for (s32 class_index = 0; class_index < MagazineClassCount; ++class_index) {
+                        if (m_counts[class_index] == 0) {
+                            continue;
+                        }
+
+                        const size_t size = MagazineClasses[class_index].size;
+                        {
+                            std::scoped_lock hk(g_heap_mutex);
+
+                            const s32 order = g_heap.GetOrderFromBytes(size);
+                            while (m_counts[class_index] > 0) {
+                                g_heap.Free(m_buffers[class_index][--m_counts[class_index]], order);
+                                g_magazine_cached_size -= size;
+                            }
+                        }
+
+                        drained = true;
+                    }
+
+                    return drained;
+                }
+        };
+
+        constinit BufferMagazine g_magazines[MagazineShardCount];
+
+        BufferMagazine &GetCurrentBufferMagazine() {
+            return g_magazines[static_cast<u32>(os::GetCurrentCoreNumber()) % MagazineShardCount];
+        }
+
+        s32 GetMagazineClassIndexForAllocation(size_t target_size, size_t required_size) {
+            /* Only use a magazine when the heap would have handed out a buffer of exactly the class size, untrimmed. */
+            for (s32 i = 0; i < MagazineClassCount; ++i) {
+                const size_t size = MagazineClasses[i].size;
+                if (required_size <= size && size / 2 < target_size && target_size <= size && size < target_size + HeapAllocatableSizeTrim) {
+                    return i;
+                }
+            }
+            return -1;
+        }
+
+        s32 GetMagazineClassIndexForDeallocation(const char *buffer, size_t size) {
+            for (s32 i = 0; i < MagazineClassCount; ++i) {
+                if (MagazineClasses[i].size == size) {
+                    /* Only whole buddy blocks may be cached. */
+                    return util::IsAligned(static_cast<size_t>(buffer - static_cast<char *>(g_heap_buffer)), size) ? i : -1;
+                }
+            }
+            return -1;
+        }
+
+        bool DrainBufferMagazines() {
+            bool drained = false;
+            for (auto &magazine : g_magazines) {
+                drained |= magazine.Drain();
+            }
+            return drained;
+        }
+
     }
 
     size_t PooledBuffer::GetAllocatableSizeMaxCore(bool large) {
@@ -105,6 +251,18 @@ namespace ams::fssystem {
 
         const size_t target_size = std::min(std::max(ideal_size, required_size), GetAllocatableSizeMaxCore(large));
 
+        /* If we can, take a cached buffer from our magazine without touching the heap. */
+        if (const s32 class_index = GetMagazineClassIndexForAllocation(target_size, required_size); class_index >= 0) {
+            if (char *buffer = GetCurrentBufferMagazine().Pop(class_index); buffer != nullptr) {
+                m_buffer = buffer;
+                m_size   = MagazineClasses[class_index].size;
+                g_magazine_hit_count++;
+                return;
+            }
+
+            g_magazine_fallback_count++;
+        }
+
         /* Loop until we allocate. */
         while (true) {
             /* Lock the heap and try to allocate. */
@@ -141,6 +299,9 @@ namespace ams::fssystem {
                     g_reduce_allocation_count++;
                 }
                 break;
+            } else if (DrainBufferMagazines()) {
+                /* We returned cached buffers to the heap, so retry immediately. */
+                continue;
             } else {
                 /* Sleep. */
                 os::SleepThread(RetryWait);
@@ -168,6 +329,15 @@ namespace ams::fssystem {
             AMS_ASSERT(m_buffer != nullptr);
             AMS_ASSERT(g_heap.GetBlockSize() == HeapBlockSize);
 
+            /* If we're releasing a buffer of a size we cache, try to return it to our magazine. */
+            if (ideal_size == 0) {
+                if (const s32 class_index = GetMagazineClassIndexForDeallocation(m_buffer, m_size); class_index >= 0 && GetCurrentBufferMagazine().Push(class_index, m_buffer)) {
+                    m_buffer = nullptr;
+                    m_size   = 0;
+                    return;
+                }
+            }
+
             const size_t new_size = util::AlignUp(ideal_size, HeapBlockSize);
 
             /* Repeatedly free the tail of our buffer until we're done. */
@@ -247,11 +417,26 @@ namespace ams::fssystem {
         return g_heap_free_size_peak;
     }
 
+    size_t GetPooledBufferMagazineHitCount() {
+        return g_magazine_hit_count;
+    }
+
+    size_t GetPooledBufferMagazineFallbackCount() {
+        return g_magazine_fallback_count;
+    }
+
+    size_t GetPooledBufferMagazineCachedSizePeak() {
+        return g_magazine_cached_size_peak;
+    }
+
     void ClearPooledBufferPeak() {
         std::scoped_lock lk(g_heap_mutex);
-        g_heap_free_size_peak     = g_heap.GetTotalFreeSize();
-        g_retry_count             = 0;
-        g_reduce_allocation_count = 0;
+        g_heap_free_size_peak       = g_heap.GetTotalFreeSize();
+        g_retry_count               = 0;
+        g_reduce_allocation_count   = 0;
+        g_magazine_hit_count        = 0;
+        g_magazine_fallback_count   = 0;
+        g_magazine_cached_size_peak = g_magazine_cached_size.load();
     }
 
     void RegisterAdditionalDeviceAddress(uintptr_t address, size_t size) {
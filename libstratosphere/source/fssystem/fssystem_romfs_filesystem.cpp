@@ -23,6 +23,138 @@ namespace ams::fssystem {
             return header.directory_bucket_size + header.directory_entry_size + header.file_bucket_size + header.file_entry_size;
         }
 
+        /* NOTE: An entry whose offset is this value shares its hash with another path, and must be resolved by the table. */
+        constexpr inline s64 AmbiguousPathIndexOffset = -1;
+
+        constexpr u64 CalculatePathIndexHash(const char *path, size_t length) {
+            /* Calculate the FNV-1a hash of the path. */
+            u64 hash = UINT64_C(0xCBF29CE484222325);
+            for (size_t i = 0; i < length; ++i) {
+                hash ^= static_cast<u8>(path[i]);
+                hash *= UINT64_C(0x100000001B3);
+            }
+
+            /* A hash of zero denotes an empty slot, so never produce one. */
+            return hash != 0 ? hash : 1;
+        }
+
+        template<typename Entry>
+        class RomFsPathIndexBuilder {
+            private:
+                using RomFileTable = RomFsFileSystem::RomFileTable;
+
+                struct Frame {
+                    RomFileTable::FindPosition find;
+                    size_t path_len;
+                };
+
+                /* NOTE: Every level of nesting adds at least two characters ("/x") to the path, which bounds the depth we can index. */
+                static constexpr size_t DepthMax = fs::EntryNameLengthMax / 2 + 1;
+            private:
+                RomFileTable *m_table;
+                Entry *m_entries;
+                size_t m_mask;
+                size_t m_count;
+                size_t m_count_max;
+                size_t m_visits_remaining;
+                char m_path[fs::EntryNameLengthMax + 1];
+                fs::RomPathChar m_name[fs::RomPathTool::MaxPathLength + 1];
+            public:
+                RomFsPathIndexBuilder(RomFileTable *table, Entry *entries, size_t capacity, size_t max_visits) : m_table(table), m_entries(entries), m_mask(capacity - 1), m_count(0), m_count_max(capacity - capacity / 4), m_visits_remaining(max_visits) {
+                    AMS_ASSERT(util::IsPowerOfTwo(capacity));
+                    std::memset(m_entries, 0, sizeof(Entry) * capacity);
+                }
+
+                Result Build() {
+                    /* Walk the directory tree depth-first with an explicit stack, so that deep trees can't exhaust the caller's stack. */
+                    auto stack = fs::impl::MakeUnique<Frame[]>(DepthMax);
+                    R_UNLESS(stack != nullptr, fs::ResultAllocationFailureInRomFsFileSystemB());
+
+                    size_t depth = 0;
+                    R_TRY(this->PushDirectory(stack.get(), std::addressof(depth), RomFileTable::PositionToDirectoryId(RomFileTable::RootPosition), 0));
+
+                    while (depth > 0 && m_count < m_count_max) {
+                        Frame &frame = stack[depth - 1];
+
+                        /* Descend into the next subdirectory, or return to the parent once there are none left. */
+                        const auto dir_pos = frame.find.next_dir;
+                        R_TRY_CATCH(m_table->FindNextDirectory(m_name, std::addressof(frame.find), sizeof(m_name))) {
+                            R_CATCH(fs::ResultDbmFindFinished) { --depth; continue; }
+                        } R_END_TRY_CATCH;
+
+                        /* Guard against corrupted tables whose entries form a cycle. */
+                        R_UNLESS(m_visits_remaining-- > 0, fs::ResultDbmInvalidOperation());
+
+                        size_t dir_path_len;
+                        if (this->AppendName(std::addressof(dir_path_len), frame.path_len)) {
+                            R_TRY(this->PushDirectory(stack.get(), std::addressof(depth), RomFileTable::PositionToDirectoryId(dir_pos), dir_path_len));
+                        }
+                    }
+
+                    return ResultSuccess();
+                }
+            private:
+                bool AppendName(size_t *out, size_t path_len) {
+                    const size_t name_len = strnlen(m_name, sizeof(m_name));
+                    if (path_len + 1 + name_len >= sizeof(m_path)) {
+                        return false;
+                    }
+
+                    m_path[path_len] = '/';
+                    std::memcpy(m_path + path_len + 1, m_name, name_len);
+                    *out = path_len + 1 + name_len;
+                    return true;
+                }
+
+                void Insert(u64 hash, fs::RomFileId id, const RomFileTable::FileInfo &info) {
+                    for (size_t i = hash & m_mask; /* ... */; i = (i + 1) & m_mask) {
+                        Entry &entry = m_entries[i];
+                        if (entry.hash == 0) {
+                            entry.hash = hash;
+                            entry.id   = id;
+                            entry.info = info;
+                            ++m_count;
+                            return;
+                        } else if (entry.hash == hash) {
+                            entry.info.offset = AmbiguousPathIndexOffset;
+                            return;
+                        }
+                    }
+                }
+
+                Result PushDirectory(Frame *stack, size_t *depth, fs::RomDirectoryId id, size_t path_len) {
+                    /* AppendName bounds the path length, and thereby the depth. */
+                    AMS_ASSERT(*depth < DepthMax);
+
+                    Frame &frame = stack[(*depth)++];
+                    frame.path_len = path_len;
+                    R_TRY(m_table->FindOpen(std::addressof(frame.find), id));
+
+                    /* Index all files in the directory. */
+                    while (m_count < m_count_max) {
+                        const auto file_pos = frame.find.next_file;
+                        R_TRY_CATCH(m_table->FindNextFile(m_name, std::addressof(frame.find), sizeof(m_name))) {
+                            R_CATCH(fs::ResultDbmFindFinished) { break; }
+                        } R_END_TRY_CATCH;
+
+                        /* Guard against corrupted tables whose entries form a cycle. */
+                        R_UNLESS(m_visits_remaining-- > 0, fs::ResultDbmInvalidOperation());
+
+                        size_t file_path_len;
+                        if (this->AppendName(std::addressof(file_path_len), path_len)) {
+                            const auto file_id = RomFileTable::PositionToFileId(file_pos);
+
+                            RomFileTable::FileInfo info;
+                            R_TRY(m_table->OpenFile(std::addressof(info), file_id));
+
+                            this->Insert(CalculatePathIndexHash(m_path, file_path_len), file_id, info);
+                        }
+                    }
+
+                    return ResultSuccess();
+                }
+        };
+
         class RomFsFile : public ams::fs::fsa::IFile, public ams::fs::impl::Newable {
             private:
                 RomFsFileSystem *m_parent;
@@ -190,7 +322,7 @@ namespace ams::fssystem {
     }
 
 
-    RomFsFileSystem::RomFsFileSystem() : m_base_storage() {
+    RomFsFileSystem::RomFsFileSystem() : m_base_storage(), m_path_index(), m_path_index_count(0) {
         /* ... */
     }
 
@@ -269,6 +401,11 @@ namespace ams::fssystem {
                                           fs::SubStorage(m_file_bucket_storage.get(), 0, static_cast<u32>(header.file_bucket_size)),
                                           fs::SubStorage(m_file_entry_storage.get(),  0, static_cast<u32>(header.file_entry_size))));
 
+        /* If our tables are in memory, build an index to let us resolve paths without walking them. */
+        if (use_cache) {
+            this->BuildPathIndex(header);
+        }
+
         /* Set members. */
         m_entry_size = header.body_offset;
         m_base_storage = base;
@@ -280,7 +417,69 @@ namespace ams::fssystem {
         return this->Initialize(m_shared_storage.get(), work, work_size, use_cache);
     }
 
+    void RomFsFileSystem::BuildPathIndex(const fs::RomFileSystemInformation &header) {
+        /* NOTE: The table only counts entries it adds itself, so bound the entry counts by the smallest possible entry size instead. */
+        const size_t file_count_max = static_cast<size_t>(header.file_entry_size) / RomFileTable::QueryFileEntrySize(0);
+        const size_t dir_count_max  = static_cast<size_t>(header.directory_entry_size) / RomFileTable::QueryDirectoryEntrySize(0);
+        if (file_count_max == 0) {
+            return;
+        }
+
+        /* Determine the index capacity, keeping the load factor at most one half where our budget allows. */
+        const size_t capacity = std::min(util::CeilingPowerOfTwo(std::max<size_t>(file_count_max * 2, 4)), PathIndexCountMax);
+
+        /* Allocate the index. If we can't, we'll simply resolve all paths via the table. */
+        auto index = fs::impl::MakeUnique<PathIndexEntry[]>(capacity);
+        if (index == nullptr) {
+            return;
+        }
+
+        /* Build the index. If the budget is exhausted, the index will only cover part of the file system; */
+        /* paths which aren't found will fall back to the table. */
+        RomFsPathIndexBuilder<PathIndexEntry> builder(std::addressof(m_rom_file_table), index.get(), capacity, file_count_max + dir_count_max);
+        if (R_FAILED(builder.Build())) {
+            return;
+        }
+
+        m_path_index       = std::move(index);
+        m_path_index_count = capacity;
+    }
+
+    bool RomFsFileSystem::FindInPathIndex(RomFileTable::FileInfo *out, const char *path) {
+        const size_t path_len = strnlen(path, fs::EntryNameLengthMax + 1);
+        if (path_len > fs::EntryNameLengthMax) {
+            return false;
+        }
+
+        const u64 hash = CalculatePathIndexHash(path, path_len);
+        const size_t mask = m_path_index_count - 1;
+        for (size_t i = hash & mask; /* ... */; i = (i + 1) & mask) {
+            const PathIndexEntry &entry = m_path_index[i];
+            if (entry.hash == 0) {
+                return false;
+            } else if (entry.hash == hash) {
+                if (entry.info.offset.Get() == AmbiguousPathIndexOffset) {
+                    return false;
+                }
+
+                /* A matching hash doesn't imply a matching path, so check the entry's path against the table. */
+                bool is_match;
+                if (R_FAILED(m_rom_file_table.IsFilePath(std::addressof(is_match), entry.id, path, path_len)) || !is_match) {
+                    return false;
+                }
+
+                *out = entry.info;
+                return true;
+            }
+        }
+    }
+
     Result RomFsFileSystem::GetFileInfo(RomFileTable::FileInfo *out, const char *path) {
+        /* Try to resolve the path via our index, if we have one. */
+        if (m_path_index != nullptr && this->FindInPathIndex(out, path)) {
+            return ResultSuccess();
+        }
+
         R_TRY(buffers::DoContinuouslyUntilBufferIsAllocated([=, this]() -> Result {
             R_TRY_CATCH(m_rom_file_table.OpenFile(out, path)) {
                 R_CONVERT(fs::ResultDbmNotFound,         fs::ResultPathNotFound());
@@ -41,4 +41,14 @@ namespace ams::fssystem {
         return ResultSuccess();
     }
 
+    void SparseStorage::ReadAsync(s64 offset, void *buffer, size_t size, fs::IStorageCompletion *completion) {
+        /* An empty table has no data storage reads to issue, so just zero-fill synchronously. */
+        if (this->GetEntryTable().IsEmpty()) {
+            AMS_ASSERT(completion != nullptr);
+            return completion->OnCompleted(this->Read(offset, buffer, size));
+        }
+
+        return IndirectStorage::ReadAsync(offset, buffer, size, completion);
+    }
+
 }
@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) Atmosphère-NX
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms and conditions of the GNU General Public License,
+ * version 2, as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <stratosphere.hpp>
+
+namespace ams::fssystem {
+
+    void StorageCompletionQueue::Request::OnCompleted(Result result) {
+        return m_queue->Complete(this, result);
+    }
+
+    Result StorageCompletionQueue::Initialize(s32 thread_count, void *stack_buffer, size_t stack_buffer_size, s32 priority) {
+        /* Validate pre-conditions. */
+        AMS_ASSERT(0 < thread_count && thread_count <= ThreadPool::ThreadCountMax);
+
+        /* Ensure that each thread gets a large enough stack. */
+        R_UNLESS(util::AlignDown(stack_buffer_size / thread_count, os::ThreadStackAlignment) >= ThreadStackSizeMin, fs::ResultInvalidSize());
+
+        return m_thread_pool.Initialize(thread_count, stack_buffer, stack_buffer_size, priority);
+    }
+
+    void StorageCompletionQueue::Finalize() {
+        /* Ensure that nothing still refers to us. */
+        while (this->Wait() != nullptr) {
+            /* ... */
+        }
+
+        m_thread_pool.Finalize();
+    }
+
+    void StorageCompletionQueue::SubmitRead(Request *request, fs::IStorage *storage, s64 offset, void *buffer, size_t size, void *user_data) {
+        AMS_ASSERT(request != nullptr);
+        AMS_ASSERT(storage != nullptr);
+
+        /* Set up the request. */
+        request->m_storage     = storage;
+        request->m_operation   = Request::Operation::Read;
+        request->m_offset      = offset;
+        request->m_size        = static_cast<s64>(size);
+        request->m_buffer      = buffer;
+        request->m_buffer_size = size;
+        request->m_user_data   = user_data;
+
+        return this->Submit(request);
+    }
+
+    void StorageCompletionQueue::SubmitOperateRange(Request *request, fs::IStorage *storage, void *dst, size_t dst_size, fs::OperationId op_id, s64 offset, s64 size, const void *src, size_t src_size, void *user_data) {
+        AMS_ASSERT(request != nullptr);
+        AMS_ASSERT(storage != nullptr);
+
+        /* Set up the request. */
+        request->m_storage      = storage;
+        request->m_operation    = Request::Operation::OperateRange;
+        request->m_operation_id = op_id;
+        request->m_offset       = offset;
+        request->m_size         = size;
+        request->m_buffer       = dst;
+        request->m_buffer_size  = dst_size;
+        request->m_src          = src;
+        request->m_src_size     = src_size;
+        request->m_user_data    = user_data;
+
+        return this->Submit(request);
+    }
+
+    void StorageCompletionQueue::Submit(Request *request) {
+        /* Note that the request is outstanding. */
+        {
+            std::scoped_lock lk(m_mutex);
+
+            AMS_ASSERT(!request->m_is_pending);
+            request->m_queue      = this;
+            request->m_result     = ResultSuccess();
+            request->m_is_pending = true;
+
+            ++m_outstanding_count;
+        }
+
+        /* Start the request on one of our threads, or on the calling thread if we have none. */
+        if (!m_thread_pool.TryExecuteAsync(std::addressof(request->m_task), ExecuteRequest, request)) {
+            ExecuteRequest(0, request);
+        }
+    }
+
+    void StorageCompletionQueue::ExecuteRequest(s32 index, void *arg) {
+        AMS_UNUSED(index);
+
+        auto *request = static_cast<Request *>(arg);
+        switch (request->m_operation) {
+            case Request::Operation::Read:
+                return request->m_storage->ReadAsync(request->m_offset, request->m_buffer, request->m_buffer_size, request);
+            case Request::Operation::OperateRange:
+                return request->m_storage->OperateRangeAsync(request->m_buffer, request->m_buffer_size, request->m_operation_id, request->m_offset, request->m_size, request->m_src, request->m_src_size, request);
+            AMS_UNREACHABLE_DEFAULT_CASE();
+        }
+    }
+
+    void StorageCompletionQueue::Complete(Request *request, Result result) {
+        std::scoped_lock lk(m_mutex);
+
+        AMS_ASSERT(request->m_is_pending);
+        request->m_result     = result;
+        request->m_is_pending = false;
+
+        m_completed_requests.push_back(*request);
+        m_cv.Broadcast();
+    }
+
+    StorageCompletionQueue::Request *StorageCompletionQueue::PopCompletedRequest(bool wait) {
+        Request *request = nullptr;
+        {
+            std::scoped_lock lk(m_mutex);
+
+            /* Wait for a request to complete, if we should. */
+            while (wait && m_outstanding_count > 0 && m_completed_requests.empty()) {
+                m_cv.Wait(m_mutex);
+            }
+
+            if (m_completed_requests.empty()) {
+                return nullptr;
+            }
+
+            request = std::addressof(m_completed_requests.front());
+            m_completed_requests.pop_front();
+            --m_outstanding_count;
+        }
+
+        /* The request may have completed while its worker was still returning, so ensure the worker is done with it before handing it back. */
+        m_thread_pool.WaitAsync(std::addressof(request->m_task));
+
+        return request;
+    }
+
+    StorageCompletionQueue::Request *StorageCompletionQueue::Wait() {
+        return this->PopCompletedRequest(true);
+    }
+
+    StorageCompletionQueue::Request *StorageCompletionQueue::TryWait() {
+        return this->PopCompletedRequest(false);
+    }
+
+}
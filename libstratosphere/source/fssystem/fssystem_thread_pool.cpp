@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) Atmosphère-NX
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms and conditions of the GNU General Public License,
+ * version 2, as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <stratosphere.hpp>
+
+namespace ams::fssystem {
+
+    namespace {
+
+        constinit ThreadPool *g_registered_thread_pool = nullptr;
+
+    }
+
+    void RegisterThreadPool(ThreadPool *pool) {
+        g_registered_thread_pool = pool;
+    }
+
+    ThreadPool *GetRegisteredThreadPool() {
+        return g_registered_thread_pool;
+    }
+
+    Result ThreadPool::Initialize(s32 thread_count, void *stack_buffer, size_t stack_buffer_size, s32 priority) {
+        /* Validate pre-conditions. */
+        AMS_ASSERT(m_thread_count == 0);
+        AMS_ASSERT(0 < thread_count && thread_count <= ThreadCountMax);
+        AMS_ASSERT(stack_buffer != nullptr);
+        AMS_ASSERT(util::IsAligned(reinterpret_cast<uintptr_t>(stack_buffer), os::ThreadStackAlignment));
+
+        /* Split the stack buffer evenly between our threads. */
+        const size_t stack_size = util::AlignDown(stack_buffer_size / thread_count, os::ThreadStackAlignment);
+        AMS_ASSERT(stack_size > 0);
+
+        /* If we fail to create any thread, tear down the ones we did create. */
+        auto thread_guard = SCOPE_GUARD { this->Finalize(); };
+
+        m_finalizing = false;
+        for (s32 i = 0; i < thread_count; ++i) {
+            void *stack = static_cast<u8 *>(stack_buffer) + stack_size * i;
+            R_TRY(os::CreateThread(m_threads + i, ThreadEntry, this, stack, stack_size, priority));
+            os::SetThreadNamePointer(m_threads + i, AMS_GET_SYSTEM_THREAD_NAME(fs, WorkerThreadPool));
+
+            /* Allow our workers to run on any core available to us, so that they can actually execute in parallel. */
+            os::SetThreadCoreMask(m_threads + i, os::IdealCoreDontCare, os::GetThreadAvailableCoreMask());
+            os::StartThread(m_threads + i);
+
+            ++m_thread_count;
+        }
+
+        m_thread_stack_size = stack_size;
+
+        thread_guard.Cancel();
+        return ResultSuccess();
+    }
+
+    void ThreadPool::Finalize() {
+        /* Signal our threads to exit. */
+        {
+            std::scoped_lock lk(m_mutex);
+
+            AMS_ASSERT(m_jobs.empty());
+            m_finalizing = true;
+            m_job_cv.Broadcast();
+        }
+
+        /* Wait for and destroy our threads. */
+        for (s32 i = 0; i < m_thread_count; ++i) {
+            os::WaitThread(m_threads + i);
+            os::DestroyThread(m_threads + i);
+        }
+        m_thread_count      = 0;
+        m_thread_stack_size = 0;
+    }
+
+    void ThreadPool::ExecuteParallel(ParallelFunction function, void *arg, s32 count) {
+        /* If there's nothing to distribute, just run everything on the calling thread. */
+        if (m_thread_count == 0 || count <= 1) {
+            for (s32 i = 0; i < count; ++i) {
+                function(i, arg);
+            }
+            return;
+        }
+
+        /* Publish the job to our workers. */
+        Job job;
+        job.function  = function;
+        job.argument  = arg;
+        job.count     = count;
+        job.next      = 0;
+        job.completed = 0;
+
+        std::scoped_lock lk(m_mutex);
+
+        m_jobs.push_back(job);
+        m_job_cv.Broadcast();
+
+        /* Help execute our own job, rather than sleeping while it runs. */
+        while (job.next < job.count) {
+            this->ExecuteOneLocked(std::addressof(job));
+        }
+
+        /* Wait for any invocations still running on workers. */
+        while (job.completed < job.count) {
+            m_done_cv.Wait(m_mutex);
+        }
+    }
+
+    bool ThreadPool::TryExecuteAsync(AsyncTask *task, ParallelFunction function, void *arg) {
+        AMS_ASSERT(task != nullptr);
+
+        /* Without workers, nothing would ever run the task. */
+        if (m_thread_count == 0) {
+            return false;
+        }
+
+        std::scoped_lock lk(m_mutex);
+
+        /* Don't resubmit a task which hasn't completed yet. */
+        Job &job = task->m_job;
+        if (job.completed < job.count) {
+            return false;
+        }
+
+        /* Publish the job to our workers. */
+        job.function  = function;
+        job.argument  = arg;
+        job.count     = 1;
+        job.next      = 0;
+        job.completed = 0;
+
+        m_jobs.push_back(job);
+        m_job_cv.Broadcast();
+
+        return true;
+    }
+
+    void ThreadPool::WaitAsync(AsyncTask *task) {
+        AMS_ASSERT(task != nullptr);
+
+        std::scoped_lock lk(m_mutex);
+
+        while (task->m_job.completed < task->m_job.count) {
+            m_done_cv.Wait(m_mutex);
+        }
+    }
+
+    void ThreadPool::ThreadEntry(void *arg) {
+        static_cast<ThreadPool *>(arg)->ThreadFunction();
+    }
+
+    void ThreadPool::ThreadFunction() {
+        std::scoped_lock lk(m_mutex);
+
+        while (true) {
+            /* Wait for a job (or for us to be finalized). */
+            while (!m_finalizing && m_jobs.empty()) {
+                m_job_cv.Wait(m_mutex);
+            }
+
+            if (m_finalizing) {
+                break;
+            }
+
+            /* Execute part of the oldest job. */
+            this->ExecuteOneLocked(std::addressof(m_jobs.front()));
+        }
+    }
+
+    void ThreadPool::ExecuteOneLocked(Job *job) {
+        AMS_ASSERT(m_mutex.IsLockedByCurrentThread());
+
+        /* Claim an index; once every index is claimed, no one else needs to see the job. */
+        const s32 index = job->next++;
+        if (job->next == job->count) {
+            m_jobs.erase(m_jobs.iterator_to(*job));
+        }
+
+        /* Run the function without holding our lock. */
+        m_mutex.Unlock();
+        job->function(index, job->argument);
+        m_mutex.Lock();
+
+        /* Note that we completed; the owner may be waiting for us. */
+        if ((++job->completed) == job->count) {
+            m_done_cv.Broadcast();
+        }
+    }
+
+}
@@ -17,8 +17,17 @@
 
 namespace ams::fssystem::save {
 
+    namespace {
+
+        /* NOTE: Pinned buffers can't be reclaimed by the buffer manager, so bound how much of its heap all pinned caches may hold together. */
+        constexpr inline size_t PinnedCacheSizeMax = 256_KB;
+
+        constinit std::atomic<size_t> g_pinned_cache_size = 0;
+
+    }
+
     BlockCacheBufferedStorage::BlockCacheBufferedStorage()
-        : m_buffer_manager(), m_mutex(), m_entries(), m_data_storage(), m_last_result(ResultSuccess()), m_data_size(), m_verification_block_size(), m_verification_block_shift(), m_invalidate_index(), m_max_cache_entry_count(), m_flags(), m_buffer_level(-1)
+        : m_buffer_manager(), m_mutex(), m_entries(), m_data_storage(), m_last_result(ResultSuccess()), m_data_size(), m_verification_block_size(), m_verification_block_shift(), m_invalidate_index(), m_max_cache_entry_count(), m_cache_entry_capacity(), m_flags(), m_buffer_level(-1), m_replacement_policy(CacheReplacementPolicy_Lru), m_eviction_history(), m_access_sequence(), m_hit_count(), m_miss_count(), m_eviction_count()
     {
         /* ... */
     }
@@ -27,7 +36,7 @@ namespace ams::fssystem::save {
         this->Finalize();
     }
 
-    Result BlockCacheBufferedStorage::Initialize(IBufferManager *bm, os::SdkRecursiveMutex *mtx, IStorage *data, s64 data_size, size_t verif_block_size, s32 max_cache_entries, bool is_real_data, s8 buffer_level, bool is_keep_burst_mode, fs::StorageType storage_type) {
+    Result BlockCacheBufferedStorage::Initialize(IBufferManager *bm, os::SdkRecursiveMutex *mtx, IStorage *data, s64 data_size, size_t verif_block_size, s32 max_cache_entries, bool is_real_data, s8 buffer_level, bool is_keep_burst_mode, fs::StorageType storage_type, CacheReplacementPolicy replacement_policy, s32 cache_entry_capacity) {
         /* Validate preconditions. */
         AMS_ASSERT(data != nullptr);
         AMS_ASSERT(bm   != nullptr);
@@ -38,8 +47,11 @@ namespace ams::fssystem::save {
         AMS_ASSERT(m_entries        == nullptr);
         AMS_ASSERT(max_cache_entries > 0);
 
+        /* Determine how many entries we may grow to. */
+        cache_entry_capacity = std::max(cache_entry_capacity, max_cache_entries);
+
         /* Create the entry. */
-        m_entries = fs::impl::MakeUnique<CacheEntry[]>(static_cast<size_t>(max_cache_entries));
+        m_entries = fs::impl::MakeUnique<CacheEntry[]>(static_cast<size_t>(cache_entry_capacity));
         R_UNLESS(m_entries != nullptr, fs::ResultAllocationFailureInBlockCacheBufferedStorageA());
 
         /* Set members. */
@@ -51,16 +63,25 @@ namespace ams::fssystem::save {
         m_last_result              = ResultSuccess();
         m_invalidate_index         = 0;
         m_max_cache_entry_count    = max_cache_entries;
+        m_cache_entry_capacity     = cache_entry_capacity;
         m_flags                    = 0;
         m_buffer_level             = buffer_level;
         m_storage_type             = storage_type;
+        m_replacement_policy       = replacement_policy;
+        m_access_sequence          = 0;
+        m_hit_count                = 0;
+        m_miss_count               = 0;
+        m_eviction_count           = 0;
+
+        /* Clear the eviction history. */
+        m_eviction_history.Clear();
 
         /* Calculate block shift. */
         m_verification_block_shift = ILog2(static_cast<u32>(verif_block_size));
         AMS_ASSERT(static_cast<size_t>(1ull << m_verification_block_size) == m_verification_block_size);
 
         /* Clear the entry. */
-        std::memset(m_entries.get(), 0, sizeof(CacheEntry) * m_max_cache_entry_count);
+        std::memset(m_entries.get(), 0, sizeof(CacheEntry) * m_cache_entry_capacity);
 
         /* Set burst mode. */
         this->SetKeepBurstMode(is_keep_burst_mode);
@@ -85,6 +106,7 @@ namespace ams::fssystem::save {
             m_verification_block_shift = 0;
             m_invalidate_index         = 0;
             m_max_cache_entry_count    = 0;
+            m_cache_entry_capacity     = 0;
 
             m_entries.reset();
         }
@@ -417,6 +439,34 @@ namespace ams::fssystem::save {
         }
     }
 
+    Result BlockCacheBufferedStorage::SetMaxCacheEntryCount(s32 count) {
+        /* Validate pre-conditions. */
+        AMS_ASSERT(m_entries != nullptr);
+        AMS_ASSERT(0 < count && count <= m_cache_entry_capacity);
+
+        std::scoped_lock lk(*m_mutex);
+
+        /* If we're shrinking, release the entries we're giving up, writing back any dirty data. */
+        Result result = ResultSuccess();
+        for (CacheIndex i = count; i < m_max_cache_entry_count; ++i) {
+            if (m_entries[i].is_valid) {
+                const auto cur_result = this->FlushCacheEntry(i, true);
+                if (R_FAILED(cur_result) && R_SUCCEEDED(result)) {
+                    result = cur_result;
+                }
+            }
+        }
+        R_TRY(this->UpdateLastResult(result));
+
+        /* Set the new count. */
+        m_max_cache_entry_count = count;
+        if (m_invalidate_index >= count) {
+            m_invalidate_index = 0;
+        }
+
+        return ResultSuccess();
+    }
+
     Result BlockCacheBufferedStorage::Commit() {
         /* Validate pre-conditions. */
         AMS_ASSERT(m_data_storage != nullptr);
@@ -441,11 +491,12 @@ namespace ams::fssystem::save {
         /* Release all valid entries back to the buffer manager. */
         const auto max_cache_entry_count = this->GetMaxCacheEntryCount();
         for (s32 i = 0; i < max_cache_entry_count; i++) {
-            const auto &entry = m_entries[i];
+            auto &entry = m_entries[i];
             if (entry.is_valid) {
-                if (entry.is_write_back) {
+                if (this->HoldsBuffer(entry)) {
                     AMS_ASSERT(entry.memory_address != 0 && entry.handle == 0);
                     m_buffer_manager->DeallocateBuffer(entry.memory_address, entry.memory_size);
+                    this->UnpinBuffer(std::addressof(entry));
                 } else {
                     AMS_ASSERT(entry.memory_address == 0 && entry.handle != 0);
                     const auto memory_range = m_buffer_manager->AcquireCache(entry.handle);
@@ -627,7 +678,7 @@ namespace ams::fssystem::save {
         const auto max_cache_entry_count = this->GetMaxCacheEntryCount();
         for (auto i = 0; i < max_cache_entry_count; ++i) {
             const auto &entry = m_entries[i];
-            if (entry.is_valid && (entry.is_write_back ? entry.memory_address != 0 : entry.handle != 0)) {
+            if (entry.is_valid && (this->HoldsBuffer(entry) ? entry.memory_address != 0 : entry.handle != 0)) {
                 if (entry.offset < static_cast<s64>(offset + size) && offset < static_cast<s64>(entry.offset + entry.size)) {
                     return true;
                 }
@@ -657,7 +708,7 @@ namespace ams::fssystem::save {
         size_t actual_size = ideal_size;
         for (index = 0; index < max_cache_entry_count; ++index) {
             const auto &entry = m_entries[index];
-            if (entry.is_valid && (entry.is_write_back ? entry.memory_address != 0 : entry.handle != 0)) {
+            if (entry.is_valid && (this->HoldsBuffer(entry) ? entry.memory_address != 0 : entry.handle != 0)) {
                 const s64 entry_offset = entry.offset;
                 if (entry_offset <= offset && offset < static_cast<s64>(entry_offset + entry.size)) {
                     break;
@@ -678,12 +729,15 @@ namespace ams::fssystem::save {
             auto &entry = m_entries[index];
 
             /* Get the range of the found entry. */
-            if (entry.is_write_back) {
+            if (this->HoldsBuffer(entry)) {
                 *out_range = std::make_pair(entry.memory_address, entry.memory_size);
             } else {
                 *out_range = m_buffer_manager->AcquireCache(entry.handle);
             }
 
+            /* The buffer leaves the cache with the caller, so it no longer counts as pinned. */
+            this->UnpinBuffer(std::addressof(entry));
+
             /* Get the found entry. */
             *out_entry = entry;
             AMS_ASSERT(out_entry->is_valid);
@@ -704,6 +758,9 @@ namespace ams::fssystem::save {
 
         /* If we don't have an out entry, allocate one. */
         if (out_range->first == 0) {
+            /* Note that we missed. */
+            ++m_miss_count;
+
             /* Ensure that the allocatable size is above a threshold. */
             const auto size_threshold = m_buffer_manager->GetTotalSize() / 8;
             if (m_buffer_manager->GetTotalAllocatableSize() < size_threshold) {
@@ -733,11 +790,19 @@ namespace ams::fssystem::save {
             out_entry->is_write_back  = false;
             out_entry->is_cached      = false;
             out_entry->is_flushing    = false;
+            out_entry->is_pinned      = false;
             out_entry->handle         = false;
             out_entry->memory_address = 0;
             out_entry->memory_size    = 0;
             out_entry->offset         = offset;
             out_entry->size           = actual_size;
+
+            /* Entries which were cached before, or evicted only recently, are protected under 2Q. */
+            out_entry->is_frequent    = index != max_cache_entry_count || (m_replacement_policy == CacheReplacementPolicy_TwoQueue && m_eviction_history.Remove(offset));
+        } else {
+            /* Note that we hit, and that the entry has been referenced again. */
+            ++m_hit_count;
+            out_entry->is_frequent = true;
         }
 
         /* Ensure that we ended up with a coherent out range. */
@@ -759,6 +824,39 @@ namespace ams::fssystem::save {
         m_buffer_manager->DeallocateBuffer(range.first, range.second);
     }
 
+    void BlockCacheBufferedStorage::PinBuffer(CacheEntry *entry, const MemoryRange &range) {
+        /* Validate pre-conditions. */
+        AMS_ASSERT(entry != nullptr);
+        AMS_ASSERT(!entry->is_pinned);
+
+        /* Only pinned caches pin their buffers. */
+        if (!this->IsPinnedCache()) {
+            return;
+        }
+
+        /* Reserve the buffer's size, unless that would exceed the cap. */
+        size_t cur_size = g_pinned_cache_size.load();
+        do {
+            if (cur_size + range.second > PinnedCacheSizeMax) {
+                return;
+            }
+        } while (!g_pinned_cache_size.compare_exchange_weak(cur_size, cur_size + range.second));
+
+        entry->is_pinned = true;
+    }
+
+    void BlockCacheBufferedStorage::UnpinBuffer(CacheEntry *entry) {
+        /* Validate pre-conditions. */
+        AMS_ASSERT(entry != nullptr);
+
+        /* Release the buffer's size, if we reserved it. */
+        if (entry->is_pinned) {
+            AMS_ASSERT(g_pinned_cache_size.load() >= entry->memory_size);
+            g_pinned_cache_size -= entry->memory_size;
+            entry->is_pinned = false;
+        }
+    }
+
     Result BlockCacheBufferedStorage::StoreAssociateBuffer(CacheIndex *out, const MemoryRange &range, const CacheEntry &entry) {
         /* Validate pre-conditions. */
         AMS_ASSERT(out != nullptr);
@@ -785,12 +883,13 @@ namespace ams::fssystem::save {
 
         /* If all entries are valid, we need to invalidate one. */
         if (index == max_cache_entry_count) {
-            /* Increment the index to invalidate. */
-            m_invalidate_index = (m_invalidate_index + 1) % max_cache_entry_count;
+            /* Select the index to invalidate. */
+            m_invalidate_index = this->SelectInvalidateIndex();
 
             /* Get the entry to invalidate. */
             const CacheEntry *entry_to_invalidate = std::addressof(m_entries[m_invalidate_index]);
-            AMS_UNUSED(entry_to_invalidate);
+            const s64 invalidated_offset          = entry_to_invalidate->offset;
+            const bool was_frequent               = entry_to_invalidate->is_frequent;
 
             /* Ensure that the entry can be invalidated. */
             AMS_ASSERT(entry_to_invalidate->is_valid);
@@ -803,12 +902,19 @@ namespace ams::fssystem::save {
             AMS_ASSERT(!entry_to_invalidate->is_valid);
             AMS_ASSERT(!entry_to_invalidate->is_flushing);
 
+            /* Now that the entry is really gone, count it, and remember it if it was probationary. */
+            ++m_eviction_count;
+            if (m_replacement_policy == CacheReplacementPolicy_TwoQueue && !was_frequent) {
+                m_eviction_history.Push(invalidated_offset);
+            }
+
             index = m_invalidate_index;
         }
 
         /* Store the entry. */
-        CacheEntry *entry_ptr = std::addressof(m_entries[index]);
-        *entry_ptr            = entry;
+        CacheEntry *entry_ptr      = std::addressof(m_entries[index]);
+        *entry_ptr                 = entry;
+        entry_ptr->access_sequence = ++m_access_sequence;
 
         /* Assert that the entry is valid to store. */
         AMS_ASSERT(entry_ptr->is_valid);
@@ -818,8 +924,11 @@ namespace ams::fssystem::save {
 
         /* Ensure that the new entry isn't redundant. */
         if (!ExistsRedundantCacheEntry(*entry_ptr)) {
+            /* Pin the buffer, if we're a pinned cache and there's room under the cap. */
+            this->PinBuffer(entry_ptr, range);
+
             /* Store the cache's buffer. */
-            if (entry_ptr->is_write_back) {
+            if (this->HoldsBuffer(*entry_ptr)) {
                 entry_ptr->handle = 0;
                 entry_ptr->memory_address = range.first;
                 entry_ptr->memory_size    = range.second;
@@ -843,6 +952,45 @@ namespace ams::fssystem::save {
         return ResultSuccess();
     }
 
+    BlockCacheBufferedStorage::CacheIndex BlockCacheBufferedStorage::SelectInvalidateIndex() {
+        /* Validate pre-conditions. */
+        AMS_ASSERT(m_mutex->IsLockedByCurrentThread());
+
+        const CacheIndex max_cache_entry_count = static_cast<CacheIndex>(this->GetMaxCacheEntryCount());
+
+        /* With the default policy, invalidate entries round-robin. */
+        if (m_replacement_policy == CacheReplacementPolicy_Lru) {
+            return (m_invalidate_index + 1) % max_cache_entry_count;
+        }
+
+        /* Find the oldest probationary and protected entries. */
+        CacheIndex probation = -1;
+        CacheIndex protect   = -1;
+        s32 probation_count  = 0;
+        for (CacheIndex i = 0; i < max_cache_entry_count; ++i) {
+            const auto &entry = m_entries[i];
+            AMS_ASSERT(entry.is_valid);
+
+            if (entry.is_frequent) {
+                if (protect < 0 || entry.access_sequence < m_entries[protect].access_sequence) {
+                    protect = i;
+                }
+            } else {
+                if (probation < 0 || entry.access_sequence < m_entries[probation].access_sequence) {
+                    probation = i;
+                }
+                ++probation_count;
+            }
+        }
+
+        /* Prefer evicting probationary entries once there are too many of them, or if nothing is protected. */
+        if (probation >= 0 && (protect < 0 || probation_count > GetTwoQueueProbationCountMax(max_cache_entry_count))) {
+            return probation;
+        }
+
+        return protect;
+    }
+
     Result BlockCacheBufferedStorage::FlushCacheEntry(CacheIndex index, bool invalidate) {
         /* Lock our mutex. */
         std::scoped_lock lk(*m_mutex);
@@ -860,10 +1008,11 @@ namespace ams::fssystem::save {
             AMS_ASSERT(invalidate);
 
             /* Get and release the buffer. */
-            memory_range = m_buffer_manager->AcquireCache(entry->handle);
+            memory_range = entry->is_pinned ? std::make_pair(entry->memory_address, entry->memory_size) : m_buffer_manager->AcquireCache(entry->handle);
             if (memory_range.first != 0) {
                 m_buffer_manager->DeallocateBuffer(memory_range.first, memory_range.second);
             }
+            this->UnpinBuffer(entry);
 
             /* The entry is no longer valid. */
             entry->is_valid = false;
@@ -903,15 +1052,19 @@ namespace ams::fssystem::save {
         /* If we're invalidating, release the buffer. Otherwise, register the flushed data. */
         if (invalidate) {
             m_buffer_manager->DeallocateBuffer(memory_range.first, memory_range.second);
+            this->UnpinBuffer(entry);
             entry->is_valid    = false;
             entry->is_flushing = false;
         } else {
             AMS_ASSERT(entry->is_valid);
 
-            entry->handle = m_buffer_manager->RegisterCache(memory_range.first, memory_range.second, IBufferManager::BufferAttribute(m_buffer_level));
+            /* Pinned buffers stay with us once they're clean. */
+            if (!entry->is_pinned) {
+                entry->handle = m_buffer_manager->RegisterCache(memory_range.first, memory_range.second, IBufferManager::BufferAttribute(m_buffer_level));
 
-            entry->memory_address = 0;
-            entry->memory_size    = 0;
+                entry->memory_address = 0;
+                entry->memory_size    = 0;
+            }
             entry->is_flushing    = false;
         }
 
@@ -957,9 +1110,10 @@ namespace ams::fssystem::save {
         for (auto i = 0; i < max_cache_entry_count; ++i) {
             auto &entry = m_entries[i];
             if (entry.is_valid && (entry.offset < (offset + size)) && (offset < static_cast<s64>(entry.offset + entry.size))) {
-                if (entry.is_write_back) {
+                if (this->HoldsBuffer(entry)) {
                     AMS_ASSERT(entry.memory_address != 0 && entry.handle == 0);
                     m_buffer_manager->DeallocateBuffer(entry.memory_address, entry.memory_size);
+                    this->UnpinBuffer(std::addressof(entry));
                 } else {
                     AMS_ASSERT(entry.memory_address == 0 && entry.handle != 0);
                     const auto memory_range = m_buffer_manager->AcquireCache(entry.handle);
@@ -39,12 +39,13 @@ namespace ams::fssystem::save {
             s64 m_offset;
             std::atomic<bool> m_is_valid;
             std::atomic<bool> m_is_dirty;
-            u8 m_reserved[2];
+            std::atomic<bool> m_is_frequent;
+            u8 m_reserved[1];
             s32 m_reference_count;
             Cache *m_next;
             Cache *m_prev;
         public:
-            Cache() : m_buffered_storage(nullptr), m_memory_range(InvalidAddress, 0), m_cache_handle(), m_offset(InvalidOffset), m_is_valid(false), m_is_dirty(false), m_reference_count(1), m_next(nullptr), m_prev(nullptr) {
+            Cache() : m_buffered_storage(nullptr), m_memory_range(InvalidAddress, 0), m_cache_handle(), m_offset(InvalidOffset), m_is_valid(false), m_is_dirty(false), m_is_frequent(false), m_reference_count(1), m_next(nullptr), m_prev(nullptr) {
                 /* ... */
             }
 
@@ -84,6 +85,7 @@ namespace ams::fssystem::save {
                 m_offset           = InvalidOffset;
                 m_is_valid         = false;
                 m_is_dirty         = false;
+                m_is_frequent      = false;
                 m_next             = nullptr;
                 m_prev             = nullptr;
             }
@@ -134,6 +136,7 @@ namespace ams::fssystem::save {
                     if (!this->IsValid()) {
                         m_offset = InvalidOffset;
                         m_is_dirty = false;
+                        m_is_frequent = false;
                     }
 
                     /* Ensure our buffer state is coherent. */
@@ -292,7 +295,8 @@ namespace ams::fssystem::save {
 
                 auto &base_storage = m_buffered_storage->m_base_storage;
                 R_TRY(base_storage.Read(fetch_param.offset, fetch_param.buffer, fetch_param.size));
-                m_offset = fetch_param.offset;
+                m_is_frequent = m_buffered_storage->UpdateEvictionHistory(this->GetEvictedOffset(), fetch_param.offset);
+                m_offset      = fetch_param.offset;
                 AMS_ASSERT(this->Hits(offset, 1));
 
                 return ResultSuccess();
@@ -318,7 +322,8 @@ namespace ams::fssystem::save {
                 AMS_UNUSED(buffer_size);
 
                 std::memcpy(fetch_param.buffer, buffer, fetch_param.size);
-                m_offset = fetch_param.offset;
+                m_is_frequent = m_buffered_storage->UpdateEvictionHistory(this->GetEvictedOffset(), fetch_param.offset);
+                m_offset      = fetch_param.offset;
                 AMS_ASSERT(this->Hits(offset, 1));
 
                 return ResultSuccess();
@@ -353,6 +358,29 @@ namespace ams::fssystem::save {
                 return m_is_dirty;
             }
 
+            bool IsFrequent() const {
+                AMS_ASSERT(m_buffered_storage != nullptr);
+                return m_is_frequent;
+            }
+
+            void MarkFrequent() {
+                AMS_ASSERT(m_buffered_storage != nullptr);
+                m_is_frequent = true;
+            }
+
+            s64 GetOffset() const {
+                return m_offset;
+            }
+
+            s64 GetEvictedOffset() const {
+                /* Only probationary blocks are remembered once evicted; protected ones have already proven themselves. */
+                return m_is_frequent ? InvalidOffset : m_offset;
+            }
+
+            Cache *GetNext() const {
+                return m_next;
+            }
+
             bool Hits(s64 offset, s64 size) const {
                 AMS_ASSERT(m_buffered_storage != nullptr);
                 const auto block_size = static_cast<s64>(m_buffered_storage->m_block_size);
@@ -494,7 +522,7 @@ namespace ams::fssystem::save {
                 this->Release();
                 AMS_ASSERT(m_cache == nullptr);
 
-                m_cache = m_buffered_storage->m_next_fetch_cache;
+                m_cache = m_buffered_storage->SelectFetchCache();
                 if (m_cache != nullptr) {
                     if (m_cache->IsValid()) {
                         m_cache->TryAcquireCache();
@@ -525,6 +553,11 @@ namespace ams::fssystem::save {
                 return m_cache->Invalidate();
             }
 
+            void MarkFrequent() {
+                AMS_ASSERT(m_cache != nullptr);
+                return m_cache->MarkFrequent();
+            }
+
             bool Hits(s64 offset, s64 size) const {
                 AMS_ASSERT(m_cache != nullptr);
                 return m_cache->Hits(offset, size);
@@ -583,7 +616,7 @@ namespace ams::fssystem::save {
             }
     };
 
-    BufferedStorage::BufferedStorage() : m_base_storage(), m_buffer_manager(), m_block_size(), m_base_storage_size(), m_caches(), m_cache_count(), m_next_acquire_cache(), m_next_fetch_cache(), m_mutex(), m_bulk_read_enabled() {
+    BufferedStorage::BufferedStorage() : m_base_storage(), m_buffer_manager(), m_block_size(), m_base_storage_size(), m_caches(), m_cache_count(), m_next_acquire_cache(), m_next_fetch_cache(), m_mutex(), m_bulk_read_enabled(), m_replacement_policy(CacheReplacementPolicy_Lru), m_eviction_history(), m_hit_count(0), m_miss_count(0), m_read_ahead_thread_pool(), m_read_ahead_task(), m_sequential_offset(InvalidOffset), m_sequential_count(), m_read_ahead_depth(), m_read_ahead_offset(), m_read_ahead_offset_end() {
         /* ... */
     }
 
@@ -591,7 +624,7 @@ namespace ams::fssystem::save {
        this->Finalize();
     }
 
-    Result BufferedStorage::Initialize(fs::SubStorage base_storage, IBufferManager *buffer_manager, size_t block_size, s32 buffer_count) {
+    Result BufferedStorage::Initialize(fs::SubStorage base_storage, IBufferManager *buffer_manager, size_t block_size, s32 buffer_count, CacheReplacementPolicy replacement_policy) {
         AMS_ASSERT(buffer_manager != nullptr);
         AMS_ASSERT(block_size > 0);
         AMS_ASSERT(util::IsPowerOfTwo(block_size));
@@ -603,8 +636,14 @@ namespace ams::fssystem::save {
         /* Set members. */
         m_base_storage   = base_storage;
         m_buffer_manager = buffer_manager;
-        m_block_size     = block_size;
-        m_cache_count    = buffer_count;
+        m_block_size         = block_size;
+        m_cache_count        = buffer_count;
+        m_replacement_policy = replacement_policy;
+
+        /* Reset our replacement statistics. */
+        m_eviction_history.Clear();
+        m_hit_count  = 0;
+        m_miss_count = 0;
 
         /* Allocate the caches. */
         m_caches.reset(new Cache[buffer_count]);
@@ -620,6 +659,8 @@ namespace ams::fssystem::save {
     }
 
     void BufferedStorage::Finalize() {
+        this->WaitReadAhead();
+
         m_base_storage = fs::SubStorage();
         m_base_storage_size = 0;
         m_caches.reset();
@@ -638,6 +679,12 @@ namespace ams::fssystem::save {
 
         /* Do the read. */
         R_TRY(this->ReadCore(offset, buffer, size));
+
+        /* Prefetch ahead of the read, if it looks sequential. */
+        if (m_read_ahead_thread_pool != nullptr) {
+            this->UpdateReadAhead(offset, size);
+        }
+
         return ResultSuccess();
     }
 
@@ -650,6 +697,9 @@ namespace ams::fssystem::save {
         /* Validate arguments. */
         R_UNLESS(buffer != nullptr, fs::ResultNullptrArgument());
 
+        /* Don't race a fetch for the region we're about to write. */
+        this->WaitReadAhead();
+
         /* Do the write. */
         R_TRY(this->WriteCore(offset, buffer, size));
         return ResultSuccess();
@@ -665,6 +715,8 @@ namespace ams::fssystem::save {
 
     Result BufferedStorage::SetSize(s64 size) {
         AMS_ASSERT(this->IsInitialized());
+        this->WaitReadAhead();
+
         const s64 prev_size = m_base_storage_size;
         if (prev_size < size) {
             /* Prepare to expand. */
@@ -722,6 +774,8 @@ namespace ams::fssystem::save {
 
         /* Invalidate caches, if we should. */
         if (op_id == fs::OperationId::Invalidate) {
+            this->WaitReadAhead();
+
             SharedCache cache(this);
             while (cache.AcquireNextOverlappedCache(offset, size)) {
                 cache.Invalidate();
@@ -733,6 +787,7 @@ namespace ams::fssystem::save {
 
     void BufferedStorage::InvalidateCaches() {
         AMS_ASSERT(this->IsInitialized());
+        this->WaitReadAhead();
 
         SharedCache cache(this);
         while (cache.AcquireNextValidCache()) {
@@ -740,6 +795,169 @@ namespace ams::fssystem::save {
         }
     }
 
+    BufferedStorage::Cache *BufferedStorage::SelectFetchCache() {
+        AMS_ASSERT(m_mutex.IsLockedByCurrentThread());
+
+        /* The fetch list runs from least to most recently released, with invalid caches placed at its head. */
+        Cache * const head = m_next_fetch_cache;
+        if (head == nullptr || !head->IsValid() || m_replacement_policy == CacheReplacementPolicy_Lru) {
+            return head;
+        }
+
+        /* Find the oldest probationary and protected caches. */
+        Cache *probation    = nullptr;
+        Cache *protect      = nullptr;
+        s32 probation_count = 0;
+        Cache *cache        = head;
+        do {
+            if (!cache->IsValid()) {
+                return cache;
+            }
+
+            if (cache->IsFrequent()) {
+                if (protect == nullptr) {
+                    protect = cache;
+                }
+            } else {
+                if (probation == nullptr) {
+                    probation = cache;
+                }
+                ++probation_count;
+            }
+
+            cache = cache->GetNext();
+        } while (cache != head);
+
+        /* Prefer evicting probationary caches once there are too many of them, or if nothing is protected. */
+        if (probation != nullptr && (protect == nullptr || probation_count > GetTwoQueueProbationCountMax(m_cache_count))) {
+            return probation;
+        }
+
+        return protect;
+    }
+
+    bool BufferedStorage::UpdateEvictionHistory(s64 evicted_offset, s64 fetched_offset) {
+        if (m_replacement_policy == CacheReplacementPolicy_Lru) {
+            return false;
+        }
+
+        std::scoped_lock lk(m_mutex);
+
+        /* The previous contents are gone only now that the fetch has succeeded, so record them here. */
+        if (evicted_offset != InvalidOffset) {
+            m_eviction_history.Push(evicted_offset);
+        }
+
+        /* Tell the caller whether the fetched block was itself evicted recently. */
+        return m_eviction_history.Remove(fetched_offset);
+    }
+
+    bool BufferedStorage::IsUnderMemoryPressure() const {
+        return m_buffer_manager->GetTotalAllocatableSize() < m_buffer_manager->GetTotalSize() / 4;
+    }
+
+    void BufferedStorage::UpdateReadAhead(s64 offset, size_t size) {
+        AMS_ASSERT(m_read_ahead_thread_pool != nullptr);
+
+        std::scoped_lock lk(m_mutex);
+
+        /* Track whether this read continues the previous one. */
+        const s64 offset_end = offset + static_cast<s64>(size);
+        if (offset != m_sequential_offset) {
+            m_sequential_offset     = offset_end;
+            m_sequential_count      = 0;
+            m_read_ahead_depth      = 0;
+            m_read_ahead_offset_end = 0;
+            return;
+        }
+        m_sequential_offset = offset_end;
+
+        /* Wait until we've seen enough of a stream. */
+        if ((++m_sequential_count) < ReadAheadSequentialCountMin) {
+            return;
+        }
+
+        /* Ramp up how far ahead we read while memory is plentiful, and back off under pressure. */
+        if (this->IsUnderMemoryPressure()) {
+            m_read_ahead_depth /= 2;
+        } else {
+            m_read_ahead_depth = std::min(std::max(1, m_read_ahead_depth * 2), std::min(ReadAheadDepthMax, m_cache_count / 2));
+        }
+        if (m_read_ahead_depth == 0) {
+            return;
+        }
+
+        /* Determine the range to prefetch, skipping whatever we've already prefetched. */
+        const s64 next_offset = util::AlignDown(offset_end, m_block_size);
+        const s64 start       = std::max(next_offset, m_read_ahead_offset_end);
+        const s64 end         = std::min(next_offset + static_cast<s64>(m_read_ahead_depth * m_block_size), m_base_storage_size);
+        if (start >= end) {
+            return;
+        }
+
+        /* Submit the prefetch, unless the previous one is still running. */
+        if (m_read_ahead_thread_pool->TryExecuteAsync(std::addressof(m_read_ahead_task), ReadAheadFunction, this)) {
+            m_read_ahead_offset     = start;
+            m_read_ahead_offset_end = end;
+        }
+    }
+
+    void BufferedStorage::WaitReadAhead() {
+        if (m_read_ahead_thread_pool != nullptr) {
+            m_read_ahead_thread_pool->WaitAsync(std::addressof(m_read_ahead_task));
+        }
+    }
+
+    void BufferedStorage::ReadAheadFunction(s32 index, void *arg) {
+        AMS_UNUSED(index);
+        static_cast<BufferedStorage *>(arg)->ReadAhead();
+    }
+
+    void BufferedStorage::ReadAhead() {
+        /* Get the range to prefetch. */
+        s64 offset, offset_end;
+        {
+            std::scoped_lock lk(m_mutex);
+            offset     = m_read_ahead_offset;
+            offset_end = m_read_ahead_offset_end;
+        }
+
+        for (/* ... */; offset < offset_end; offset += m_block_size) {
+            /* Foreground reads need memory more than we do. */
+            if (this->IsUnderMemoryPressure()) {
+                break;
+            }
+
+            /* Skip blocks which are already cached. */
+            SharedCache cache(this);
+            if (cache.AcquireNextOverlappedCache(offset, 1)) {
+                continue;
+            }
+
+            /* Get a cache to fetch into; if anyone else is using it, give up rather than contend with them. */
+            if (!cache.AcquireFetchableCache()) {
+                break;
+            }
+
+            bool fetched = false;
+            {
+                UniqueCache fetch_cache(this);
+                const auto upgrade_result = fetch_cache.Upgrade(cache);
+                if (R_FAILED(upgrade_result.first) || !upgrade_result.second) {
+                    break;
+                }
+
+                fetched = R_SUCCEEDED(fetch_cache.Fetch(offset));
+            }
+
+            /* Don't leave a partially fetched block behind. */
+            if (!fetched) {
+                cache.Invalidate();
+                break;
+            }
+        }
+    }
+
     Result BufferedStorage::PrepareAllocation() {
         const auto flush_threshold = m_buffer_manager->GetTotalSize() / 8;
         if (m_buffer_manager->GetTotalAllocatableSize() < flush_threshold) {
@@ -822,7 +1040,11 @@ namespace ams::fssystem::save {
 
             if (cur_size <= m_block_size) {
                 SharedCache cache(this);
-                if (!cache.AcquireNextOverlappedCache(cur_offset, cur_size)) {
+                if (cache.AcquireNextOverlappedCache(cur_offset, cur_size)) {
+                    ++m_hit_count;
+                    cache.MarkFrequent();
+                } else {
+                    ++m_miss_count;
                     R_TRY(this->PrepareAllocation());
                     while (true) {
                         R_UNLESS(cache.AcquireFetchableCache(), fs::ResultOutOfResource());
@@ -882,6 +1104,9 @@ namespace ams::fssystem::save {
                 break;
             }
 
+            ++m_hit_count;
+            cache.MarkFrequent();
+
             cache.Read(*offset, static_cast<u8 *>(buffer) + *buffer_offset, cur_size);
             *offset        += cur_size;
             *buffer_offset += cur_size;
@@ -919,6 +1144,9 @@ namespace ams::fssystem::save {
                 break;
             }
 
+            ++m_hit_count;
+            cache.MarkFrequent();
+
             cache.Read(cur_offset, static_cast<u8 *>(buffer) + buffer_offset + cur_offset - offset, cur_size);
             *size          -= cur_size;
             is_cache_needed = false;
@@ -955,6 +1183,7 @@ namespace ams::fssystem::save {
 
         /* Read from the base storage. */
         R_TRY(m_base_storage.Read(aligned_offset, work_buffer, static_cast<size_t>(aligned_size)));
+        m_miss_count += util::DivideUp(aligned_size, static_cast<s64>(m_block_size));
         if (work_buffer != static_cast<char *>(buffer)) {
             std::memcpy(buffer, work_buffer + offset - aligned_offset, size);
         }
@@ -1041,7 +1270,11 @@ namespace ams::fssystem::save {
 
             if (cur_size <= m_block_size) {
                 SharedCache cache(this);
-                if (!cache.AcquireNextOverlappedCache(cur_offset, cur_size)) {
+                if (cache.AcquireNextOverlappedCache(cur_offset, cur_size)) {
+                    ++m_hit_count;
+                    cache.MarkFrequent();
+                } else {
+                    ++m_miss_count;
                     R_TRY(this->PrepareAllocation());
                     while (true) {
                         R_UNLESS(cache.AcquireFetchableCache(), fs::ResultOutOfResource());
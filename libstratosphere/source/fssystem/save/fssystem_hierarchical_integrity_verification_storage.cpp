@@ -28,6 +28,13 @@ namespace ams::fssystem::save {
         constexpr inline auto MaxRomFsDataCacheEntryCount      = 24;
         constexpr inline auto MaxRomFsHashCacheEntryCount      = 8;
 
+        /* Hash levels may grow to this multiple of their initial cache entry count, and the data level may shrink to its reciprocal. */
+        constexpr inline s32 CacheEntryCountAdaptiveScale = 2;
+
+        /* Cache entries are rebalanced at most once per this many cache accesses, and considered once per this many reads. */
+        constexpr inline s64 CacheRebalanceAccessCountInterval = 0x100;
+        constexpr inline u32 CacheRebalanceReadCountInterval   = 0x40;
+
         constexpr inline auto AccessCountMax = 5;
         constexpr inline auto AccessTimeout  = TimeSpan::FromMilliSeconds(10);
 
@@ -181,7 +188,7 @@ namespace ams::fssystem::save {
         };
 
         /* Initialize the top level buffer storage. */
-        R_TRY(m_buffer_storages[0].Initialize(m_buffers->buffers[0], m_mutex, std::addressof(m_verify_storages[0]), info.info[0].size, static_cast<s64>(1) << info.info[0].block_order, max_hash_cache_entry_count, false, 0x10, false, storage_type));
+        R_TRY(m_buffer_storages[0].Initialize(m_buffers->buffers[0], m_mutex, std::addressof(m_verify_storages[0]), info.info[0].size, static_cast<s64>(1) << info.info[0].block_order, max_hash_cache_entry_count, false, 0x10, false, storage_type, CacheReplacementPolicy_Lru, max_hash_cache_entry_count * CacheEntryCountAdaptiveScale));
         auto top_buffer_guard = SCOPE_GUARD { m_buffer_storages[0].Finalize(); };
 
         /* Prepare to initialize the level storages. */
@@ -207,7 +214,7 @@ namespace ams::fssystem::save {
             }
 
             /* Initialize the buffer storage. */
-            R_TRY(m_buffer_storages[level + 1].Initialize(m_buffers->buffers[level + 1], m_mutex, std::addressof(m_verify_storages[level + 1]), info.info[level + 1].size, static_cast<s64>(1) << info.info[level + 1].block_order, max_hash_cache_entry_count, false, 0x11 + static_cast<s8>(level), false, storage_type));
+            R_TRY(m_buffer_storages[level + 1].Initialize(m_buffers->buffers[level + 1], m_mutex, std::addressof(m_verify_storages[level + 1]), info.info[level + 1].size, static_cast<s64>(1) << info.info[level + 1].block_order, max_hash_cache_entry_count, false, 0x11 + static_cast<s8>(level), false, storage_type, CacheReplacementPolicy_Lru, max_hash_cache_entry_count * CacheEntryCountAdaptiveScale));
         }
 
         /* Initialize the final level storage. */
@@ -221,9 +228,30 @@ namespace ams::fssystem::save {
             }
 
             /* Initialize the buffer storage. */
+            /* NOTE: The data level gets no headroom above its initial entry count. Rebalancing never changes the total entry count and hash levels */
+            /* never shrink below their initial counts, so the data level can only ever take back entries it gave away. */
             R_TRY(m_buffer_storages[level + 1].Initialize(m_buffers->buffers[level + 1], m_mutex, std::addressof(m_verify_storages[level + 1]), info.info[level + 1].size, static_cast<s64>(1) << info.info[level + 1].block_order, max_data_cache_entry_count, true, 0x11 + static_cast<s8>(level), true, storage_type));
         }
 
+        /* Hash levels of read-only content are small and hot, so keep data traffic from evicting them through the shared buffer manager. */
+        /* NOTE: Save data hash levels are written back and change with every commit, so they stay evictable. */
+        for (s32 i = 0; i <= level; ++i) {
+            m_buffer_storages[i].SetPinnedCache(storage_type == fs::StorageType_RomFs);
+            m_cache_entry_count_min[i] = max_hash_cache_entry_count;
+        }
+        m_cache_entry_count_min[level + 1] = std::max(max_data_cache_entry_count / CacheEntryCountAdaptiveScale, 1);
+
+        /* Reset our cache statistics. */
+        std::fill(std::begin(m_last_miss_counts), std::end(m_last_miss_counts), 0);
+        m_last_rebalance_access_count = 0;
+        m_read_count                  = 0;
+
+        /* Let the lower levels prefetch signatures from the cached levels above them. */
+        /* NOTE: The top level's signatures come from the uncached master storage, so it gains nothing from prefetching. */
+        for (s32 i = 1; i <= level + 1; ++i) {
+            m_verify_storages[i].EnableSignaturePrefetch();
+        }
+
         /* Set the data size. */
         m_data_size = info.info[level + 1].size;
 
@@ -273,6 +301,13 @@ namespace ams::fssystem::save {
 
         /* Read the data. */
         R_TRY(m_buffer_storages[m_max_layers - 2].Read(offset, buffer, size));
+
+        /* Periodically adjust our caches to what we've seen. */
+        /* NOTE: The read itself has already succeeded, and a failed rebalance leaves the caches as they were, so its result is ignored. */
+        if (m_is_adaptive_cache_sizing_enabled && (++m_read_count % CacheRebalanceReadCountInterval) == 0) {
+            this->RebalanceCacheEntries();
+        }
+
         return ResultSuccess();
     }
 
@@ -334,6 +369,85 @@ namespace ams::fssystem::save {
         }
     }
 
+    void HierarchicalIntegrityVerificationStorage::QueryCacheStatistics(HierarchicalIntegrityVerificationCacheStatistics *out) {
+        AMS_ASSERT(out != nullptr);
+
+        std::scoped_lock lk(*m_mutex);
+
+        /* Gather the statistics for each level. */
+        std::memset(out, 0, sizeof(*out));
+
+        out->level_count = m_max_layers - 1;
+        for (s32 level = 0; level < out->level_count; ++level) {
+            const auto &storage = m_buffer_storages[level];
+
+            out->levels[level].hit_count         = storage.GetCacheHitCount();
+            out->levels[level].miss_count        = storage.GetCacheMissCount();
+            out->levels[level].eviction_count    = storage.GetCacheEvictionCount();
+            out->levels[level].cache_entry_count = storage.GetMaxCacheEntryCount();
+        }
+    }
+
+    Result HierarchicalIntegrityVerificationStorage::RebalanceCacheEntries() {
+        std::scoped_lock lk(*m_mutex);
+
+        /* Only rebalance once we've seen enough accesses to judge by. */
+        const s32 level_count = m_max_layers - 1;
+
+        s64 access_count = 0;
+        for (s32 level = 0; level < level_count; ++level) {
+            access_count += m_buffer_storages[level].GetCacheHitCount() + m_buffer_storages[level].GetCacheMissCount();
+        }
+        R_SUCCEED_IF(access_count - m_last_rebalance_access_count < CacheRebalanceAccessCountInterval);
+        m_last_rebalance_access_count = access_count;
+
+        /* Determine how many misses each level has had since we last rebalanced. */
+        s64 miss_counts[MaxLayers - 1];
+        for (s32 level = 0; level < level_count; ++level) {
+            const s64 miss_count = m_buffer_storages[level].GetCacheMissCount();
+            miss_counts[level]        = miss_count - m_last_miss_counts[level];
+            m_last_miss_counts[level] = miss_count;
+        }
+
+        /* Find the level which missed most and can still grow. */
+        s32 receiver = -1;
+        for (s32 level = 0; level < level_count; ++level) {
+            const auto &storage = m_buffer_storages[level];
+            if (miss_counts[level] > 0 && storage.GetMaxCacheEntryCount() < storage.GetCacheEntryCapacity()) {
+                if (receiver < 0 || miss_counts[level] > miss_counts[receiver]) {
+                    receiver = level;
+                }
+            }
+        }
+        R_SUCCEED_IF(receiver < 0);
+
+        /* Find the level which missed least and can still shrink. */
+        s32 donor = -1;
+        for (s32 level = 0; level < level_count; ++level) {
+            if (level != receiver && m_buffer_storages[level].GetMaxCacheEntryCount() > m_cache_entry_count_min[level]) {
+                if (donor < 0 || miss_counts[level] < miss_counts[donor]) {
+                    donor = level;
+                }
+            }
+        }
+        R_SUCCEED_IF(donor < 0);
+
+        /* Only move an entry if the difference is significant, so that we don't oscillate. */
+        R_SUCCEED_IF(miss_counts[receiver] <= 2 * miss_counts[donor]);
+
+        /* Move an entry. Growing can't fail, but shrinking writes back the entry given up, so grow the receiver first and undo that if the donor can't shrink. */
+        const s32 receiver_count = m_buffer_storages[receiver].GetMaxCacheEntryCount();
+        R_TRY(m_buffer_storages[receiver].SetMaxCacheEntryCount(receiver_count + 1));
+
+        /* NOTE: We hold the mutex, so nothing can have been cached in the receiver's new entry, and giving it back can't fail. */
+        auto receiver_guard = SCOPE_GUARD { R_ABORT_UNLESS(m_buffer_storages[receiver].SetMaxCacheEntryCount(receiver_count)); };
+
+        R_TRY(m_buffer_storages[donor].SetMaxCacheEntryCount(m_buffer_storages[donor].GetMaxCacheEntryCount() - 1));
+        receiver_guard.Cancel();
+
+        return ResultSuccess();
+    }
+
     Result HierarchicalIntegrityVerificationStorage::Commit() {
         for (s32 level = m_max_layers - 2; level >= 0; --level) {
             R_TRY(m_buffer_storages[level].Commit());
@@ -17,6 +17,13 @@
 
 namespace ams::fssystem::save {
 
+    namespace {
+
+        /* Unsalted block hashes are calculated in batches of up to this many. */
+        constexpr size_t VerificationBatchCount = 8;
+
+    }
+
     Result IntegrityVerificationStorage::Initialize(fs::SubStorage hs, fs::SubStorage ds, s64 verif_block_size, s64 upper_layer_verif_block_size, IBufferManager *bm, const fs::HashSalt &salt, bool is_real_data, fs::StorageType storage_type) {
         /* Validate preconditions. */
         AMS_ASSERT(verif_block_size >= HashSize);
@@ -61,6 +68,11 @@ namespace ams::fssystem::save {
 
     void IntegrityVerificationStorage::Finalize() {
         if (m_buffer_manager != nullptr) {
+            this->WaitSignaturePrefetch();
+            m_prefetch_thread_pool     = nullptr;
+            m_sequential_offset        = -1;
+            m_prefetch_sign_offset_end = 0;
+
             m_hash_storage = fs::SubStorage();
             m_data_storage = fs::SubStorage();
             m_buffer_manager = nullptr;
@@ -129,10 +141,33 @@ namespace ams::fssystem::save {
             ScopedThreadPriorityChanger cp(+1, ScopedThreadPriorityChanger::Mode::Relative);
 
             /* Loop over each signature we read. */
+            /* NOTE: Save data hashes are salted, and so must be calculated one at a time; other hashes are calculated in batches. */
+            const bool use_batch = m_storage_type != fs::StorageType_SaveData;
+            BlockHash calc_hashes[VerificationBatchCount];
+            size_t batch_start = 0, batch_end = 0;
             for (size_t i = 0; i < cur_count && R_SUCCEEDED(cur_result); ++i) {
                 const auto verified_size = (verified_count + i) << m_verification_block_order;
                 u8 *cur_buf = static_cast<u8 *>(buffer) + verified_size;
-                cur_result = this->VerifyHash(cur_buf, reinterpret_cast<BlockHash *>(signature_buffer.GetBuffer()) + i);
+                BlockHash *cur_hash = reinterpret_cast<BlockHash *>(signature_buffer.GetBuffer()) + i;
+
+                if (use_batch) {
+                    /* If we've used all the hashes we calculated, calculate the next batch. */
+                    if (i >= batch_end) {
+                        batch_start = i;
+                        batch_end   = std::min(cur_count, i + VerificationBatchCount);
+
+                        const void *batch_data[VerificationBatchCount];
+                        for (size_t j = batch_start; j < batch_end; ++j) {
+                            batch_data[j - batch_start] = cur_buf + ((j - batch_start) << m_verification_block_order);
+                        }
+
+                        crypto::GenerateSha256HashMulti(calc_hashes, sizeof(calc_hashes), batch_data, batch_end - batch_start, static_cast<size_t>(m_verification_block_size));
+                    }
+
+                    cur_result = this->VerifyCalculatedHash(calc_hashes[i - batch_start], cur_hash);
+                } else {
+                    cur_result = this->VerifyHash(cur_buf, cur_hash);
+                }
 
                 /* If the data is corrupted, clear the corrupted parts. */
                 if (fs::ResultIntegrityVerificationStorageCorrupted::Includes(cur_result)) {
@@ -157,9 +192,84 @@ namespace ams::fssystem::save {
             verified_count += cur_count;
         }
 
+        /* Prefetch the signatures for the next read, if it looks sequential. */
+        if (m_prefetch_thread_pool != nullptr) {
+            this->UpdateSignaturePrefetch(offset, size);
+        }
+
         return verify_hash_result;
     }
 
+    void IntegrityVerificationStorage::UpdateSignaturePrefetch(s64 offset, size_t size) {
+        AMS_ASSERT(m_prefetch_thread_pool != nullptr);
+
+        std::scoped_lock lk(m_prefetch_mutex);
+
+        /* Only prefetch for reads which continue the previous one. */
+        const s64 offset_end = offset + static_cast<s64>(size);
+        const bool is_sequential = offset == m_sequential_offset;
+        m_sequential_offset = offset_end;
+        if (!is_sequential) {
+            return;
+        }
+
+        /* Determine the page of signatures following those we just verified. */
+        /* NOTE: Our hash storage caches in units of the upper layer's verification block, so the page we're in is already resident. */
+        const s64 sign_offset_end = (offset_end >> m_verification_block_order) * HashSize;
+        const s64 page_offset     = util::AlignUp(sign_offset_end, static_cast<size_t>(m_upper_layer_verification_block_size));
+        if (page_offset < m_prefetch_sign_offset_end) {
+            return;
+        }
+
+        s64 hash_size;
+        if (R_FAILED(m_hash_storage.GetSize(std::addressof(hash_size)))) {
+            return;
+        }
+
+        const s64 page_offset_end = std::min(page_offset + m_upper_layer_verification_block_size, hash_size);
+        if (page_offset >= page_offset_end) {
+            return;
+        }
+
+        /* Submit the prefetch, unless the previous one is still running. */
+        if (m_prefetch_thread_pool->TryExecuteAsync(std::addressof(m_prefetch_task), PrefetchSignatureFunction, this)) {
+            m_prefetch_sign_offset     = page_offset;
+            m_prefetch_sign_offset_end = page_offset_end;
+        }
+    }
+
+    void IntegrityVerificationStorage::WaitSignaturePrefetch() {
+        if (m_prefetch_thread_pool != nullptr) {
+            m_prefetch_thread_pool->WaitAsync(std::addressof(m_prefetch_task));
+        }
+    }
+
+    void IntegrityVerificationStorage::PrefetchSignatureFunction(s32 index, void *arg) {
+        AMS_UNUSED(index);
+        static_cast<IntegrityVerificationStorage *>(arg)->PrefetchSignature();
+    }
+
+    void IntegrityVerificationStorage::PrefetchSignature() {
+        /* Get the range to prefetch. */
+        s64 sign_offset, sign_offset_end;
+        {
+            std::scoped_lock lk(m_prefetch_mutex);
+            sign_offset     = m_prefetch_sign_offset;
+            sign_offset_end = m_prefetch_sign_offset_end;
+        }
+
+        /* Read the signatures, to bring them into our hash storage's cache. Failures will be reported by the foreground read. */
+        PooledBuffer buffer(static_cast<size_t>(sign_offset_end - sign_offset), static_cast<size_t>(HashSize));
+        while (sign_offset < sign_offset_end) {
+            const size_t cur_size = static_cast<size_t>(std::min<s64>(sign_offset_end - sign_offset, buffer.GetSize()));
+            if (R_FAILED(m_hash_storage.Read(sign_offset, buffer.GetBuffer(), cur_size))) {
+                break;
+            }
+
+            sign_offset += cur_size;
+        }
+    }
+
     Result IntegrityVerificationStorage::Write(s64 offset, const void *buffer, size_t size) {
         /* Succeed if zero size. */
         R_SUCCEED_IF(size == 0);
@@ -447,6 +557,17 @@ namespace ams::fssystem::save {
         BlockHash calc_hash;
         this->CalcBlockHash(std::addressof(calc_hash), buf);
 
+        /* Check that the signatures are equal. */
+        return this->VerifyCalculatedHash(calc_hash, std::addressof(cmp_hash));
+    }
+
+    Result IntegrityVerificationStorage::VerifyCalculatedHash(const BlockHash &calc_hash, BlockHash *hash) {
+        /* Validate preconditions. */
+        AMS_ASSERT(hash != nullptr);
+
+        /* Get the comparison hash. */
+        auto &cmp_hash = *hash;
+
         /* Check that the signatures are equal. */
         if (!crypto::IsSameBytes(std::addressof(cmp_hash), std::addressof(calc_hash), sizeof(BlockHash))) {
             /* Clear the comparison hash. */
@@ -17,6 +17,13 @@
 
 namespace ams::ncm {
 
+    namespace {
+
+        /* NOTE: Reading ahead only pays off when chunks are large enough to amortize handing them to the reader thread. */
+        constexpr inline size_t PipelinedChunkSizeMin = 64_KB;
+
+    }
+
     Result PackageInstallTaskBase::Initialize(const char *package_root_path, void *buffer, size_t buffer_size, StorageId storage_id, InstallTaskDataBase *data, u32 config) {
         R_TRY(InstallTaskBase::Initialize(storage_id, data, config));
         m_package_root.Set(package_root_path);
@@ -25,6 +32,15 @@ namespace ams::ncm {
         return ResultSuccess();
     }
 
+    void PackageInstallTaskBase::EnablePipelinedWrite(void *stack, size_t stack_size) {
+        AMS_ASSERT(stack != nullptr);
+        AMS_ASSERT(util::IsAligned(reinterpret_cast<uintptr_t>(stack), os::ThreadStackAlignment));
+        AMS_ASSERT(stack_size >= fssystem::StorageCompletionQueue::ThreadStackSizeMin);
+
+        m_reader_thread_stack      = stack;
+        m_reader_thread_stack_size = stack_size;
+    }
+
     Result PackageInstallTaskBase::OnWritePlaceHolder(const ContentMetaKey &key, InstallContentInfo *content_info) {
         AMS_UNUSED(key);
 
@@ -41,6 +57,11 @@ namespace ams::ncm {
         R_TRY(fs::OpenFile(std::addressof(file), path, fs::OpenMode_Read));
         ON_SCOPE_EXIT { fs::CloseFile(file); };
 
+        /* If we were asked to, and each half of our buffer is large enough, read the next chunk of the file while we write the current one. */
+        if (m_reader_thread_stack != nullptr && m_buffer_size / 2 >= PipelinedChunkSizeMin) {
+            return this->WritePlaceHolderPipelined(content_info, file);
+        }
+
         /* Continuously write the file to the placeholder until there is nothing left to write. */
         while (true) {
             /* Read as much of the remainder of the file as possible. */
@@ -59,6 +80,52 @@ namespace ams::ncm {
         return ResultSuccess();
     }
 
+    Result PackageInstallTaskBase::WritePlaceHolderPipelined(InstallContentInfo *content_info, fs::FileHandle file) {
+        /* Get the file's size. */
+        s64 file_size;
+        R_TRY(fs::GetFileSize(std::addressof(file_size), file));
+
+        /* Split our buffer into two chunks. */
+        const size_t chunk_size = m_buffer_size / 2;
+        u8 * const chunks[2] = { static_cast<u8 *>(m_buffer), static_cast<u8 *>(m_buffer) + chunk_size };
+
+        /* Start a reader thread. */
+        /* NOTE: The queue must be destroyed first, as it waits for outstanding reads of the storage into our chunks. */
+        fs::FileHandleStorage storage(file);
+        fssystem::StorageCompletionQueue::Request requests[2];
+        fssystem::StorageCompletionQueue queue;
+        R_TRY(queue.Initialize(1, m_reader_thread_stack, m_reader_thread_stack_size, os::GetThreadPriority(os::GetCurrentThread())));
+
+        /* Create a helper to start reading the next chunk. */
+        s64 read_offset = content_info->written;
+        size_t chunk_sizes[2] = {};
+        auto submit_read = [&](s32 index) -> bool {
+            if (read_offset >= file_size) {
+                return false;
+            }
+
+            chunk_sizes[index] = static_cast<size_t>(std::min<s64>(chunk_size, file_size - read_offset));
+            queue.SubmitRead(std::addressof(requests[index]), std::addressof(storage), read_offset, chunks[index], chunk_sizes[index], nullptr);
+            read_offset += chunk_sizes[index];
+            return true;
+        };
+
+        /* Write each chunk once it's read, reading the next one meanwhile. */
+        bool has_chunk = submit_read(0);
+        for (s32 cur = 0; has_chunk; cur ^= 1) {
+            /* Wait for the current chunk. There's only ever one read outstanding, so it's the one that completes. */
+            auto *request = queue.Wait();
+            AMS_ASSERT(request == std::addressof(requests[cur]));
+            R_TRY(request->GetResult());
+
+            /* Write the current chunk while the next one is read. */
+            has_chunk = submit_read(cur ^ 1);
+            R_TRY(this->WritePlaceHolderBuffer(content_info, chunks[cur], chunk_sizes[cur]));
+        }
+
+        return ResultSuccess();
+    }
+
     Result PackageInstallTaskBase::InstallTicket(const fs::RightsId &rights_id, ContentMetaType meta_type) {
         AMS_UNUSED(meta_type);
 
@@ -20,10 +20,14 @@
 
 namespace ams::os::impl {
 
+    static_assert(sizeof(MultiWaitImpl) <= sizeof(os::MultiWaitType::impl_storage));
+    static_assert(sizeof(MultiWaitHolderCacheImpl) <= sizeof(os::MultiWaitHolderCacheType::impl_storage));
+
     Result MultiWaitImpl::WaitAnyImpl(MultiWaitHolderBase **out, bool infinite, TimeSpan timeout, bool reply, NativeHandle reply_target) {
         /* Prepare for processing. */
         m_signaled_holder = nullptr;
         m_target_impl.SetCurrentThreadHandleForCancelWait();
+        this->RefreshCache();
         MultiWaitHolderBase *holder = this->LinkHoldersToObjectList();
 
         /* Check if we've been signaled. */
@@ -60,10 +64,21 @@ namespace ams::os::impl {
     }
 
     Result MultiWaitImpl::WaitAnyHandleImpl(MultiWaitHolderBase **out, bool infinite, TimeSpan timeout, bool reply, NativeHandle reply_target) {
-        NativeHandle object_handles[MaximumHandleCount];
-        MultiWaitHolderBase *objects[MaximumHandleCount];
+        /* Use our cached handle array, if we can. */
+        NativeHandle local_handles[MaximumHandleCount];
+        MultiWaitHolderBase *local_objects[MaximumHandleCount];
+
+        NativeHandle *object_handles   = local_handles;
+        MultiWaitHolderBase **objects  = local_objects;
+        s32 count;
+        if (m_is_cache_valid) {
+            object_handles = m_cache->handles;
+            objects        = m_cache->handle_holders;
+            count          = m_handle_holder_count;
+        } else {
+            count          = this->BuildHandleArray(local_handles, local_objects, MaximumHandleCount);
+        }
 
-        const s32 count = this->BuildHandleArray(object_handles, objects, MaximumHandleCount);
         const TimeSpan end_time = infinite ? TimeSpan::FromNanoSeconds(std::numeric_limits<s64>::max()) : GetCurrentTick().ToTimeSpan() + timeout;
 
         while (true) {
@@ -152,9 +167,94 @@ namespace ams::os::impl {
         return count;
     }
 
+    void MultiWaitImpl::AddToCache(MultiWaitHolderBase &holder_base) {
+        if (const auto handle = holder_base.GetHandle(); handle != os::InvalidNativeHandle) {
+            if (m_is_cache_valid && m_handle_holder_count < static_cast<s32>(MaximumHandleCount)) {
+                m_cache->handles[m_handle_holder_count]        = handle;
+                m_cache->handle_holders[m_handle_holder_count] = std::addressof(holder_base);
+            } else {
+                m_is_cache_valid = false;
+            }
+            ++m_handle_holder_count;
+        } else {
+            if (m_is_cache_valid && m_user_object_holder_count < static_cast<s32>(MaximumUserObjectCount)) {
+                m_cache->user_object_holders[m_user_object_holder_count] = std::addressof(holder_base);
+            } else {
+                m_is_cache_valid = false;
+            }
+            ++m_user_object_holder_count;
+        }
+    }
+
+    void MultiWaitImpl::RemoveFromCache(MultiWaitHolderBase &holder_base) {
+        /* Determine which array the holder is in. */
+        const bool is_handle = holder_base.GetHandle() != os::InvalidNativeHandle;
+        s32 &holder_count = is_handle ? m_handle_holder_count : m_user_object_holder_count;
+
+        /* If our arrays are valid, remove the holder, preserving the order of the others. */
+        if (m_is_cache_valid) {
+            MultiWaitHolderBase **holders = is_handle ? m_cache->handle_holders : m_cache->user_object_holders;
+
+            s32 index = 0;
+            while (index < holder_count && holders[index] != std::addressof(holder_base)) {
+                ++index;
+            }
+            AMS_ASSERT(index < holder_count);
+
+            const s32 num_after = holder_count - (index + 1);
+            std::memmove(holders + index, holders + index + 1, num_after * sizeof(*holders));
+            if (is_handle) {
+                std::memmove(m_cache->handles + index, m_cache->handles + index + 1, num_after * sizeof(*m_cache->handles));
+            }
+        }
+
+        --holder_count;
+    }
+
+    void MultiWaitImpl::RefreshCache() {
+        /* If our arrays are already valid, there's nothing to do. */
+        if (m_is_cache_valid) {
+            return;
+        }
+
+        /* If we have no cache, or our holders still don't fit, we'll need to walk the list. */
+        if (m_cache == nullptr || m_handle_holder_count > static_cast<s32>(MaximumHandleCount) || m_user_object_holder_count > static_cast<s32>(MaximumUserObjectCount)) {
+            return;
+        }
+
+        /* Rebuild our arrays. */
+        s32 handle_count = 0, user_object_count = 0;
+        for (MultiWaitHolderBase &holder_base : m_multi_wait_list) {
+            if (const auto handle = holder_base.GetHandle(); handle != os::InvalidNativeHandle) {
+                m_cache->handles[handle_count]        = handle;
+                m_cache->handle_holders[handle_count] = std::addressof(holder_base);
+                ++handle_count;
+            } else {
+                m_cache->user_object_holders[user_object_count++] = std::addressof(holder_base);
+            }
+        }
+        AMS_ASSERT(handle_count == m_handle_holder_count);
+        AMS_ASSERT(user_object_count == m_user_object_holder_count);
+
+        m_is_cache_valid = true;
+    }
+
     MultiWaitHolderBase *MultiWaitImpl::LinkHoldersToObjectList() {
         MultiWaitHolderBase *signaled_holder = nullptr;
 
+        /* NOTE: Only user objects have object list semantics, so when we can, we only visit those. */
+        if (m_is_cache_valid) {
+            for (s32 i = 0; i < m_user_object_holder_count; ++i) {
+                TriBool is_signaled = m_cache->user_object_holders[i]->LinkToObjectList();
+
+                if (signaled_holder == nullptr && is_signaled == TriBool::True) {
+                    signaled_holder = m_cache->user_object_holders[i];
+                }
+            }
+
+            return signaled_holder;
+        }
+
         for (MultiWaitHolderBase &holder_base : m_multi_wait_list) {
             TriBool is_signaled = holder_base.LinkToObjectList();
 
@@ -167,6 +267,13 @@ namespace ams::os::impl {
     }
 
     void MultiWaitImpl::UnlinkHoldersFromObjectList() {
+        if (m_is_cache_valid) {
+            for (s32 i = 0; i < m_user_object_holder_count; ++i) {
+                m_cache->user_object_holders[i]->UnlinkFromObjectList();
+            }
+            return;
+        }
+
         for (MultiWaitHolderBase &holder_base : m_multi_wait_list) {
             holder_base.UnlinkFromObjectList();
         }
@@ -176,10 +283,20 @@ namespace ams::os::impl {
         MultiWaitHolderBase *min_timeout_holder = nullptr;
         TimeSpan min_time = end_time;
 
-        for (MultiWaitHolderBase &holder_base : m_multi_wait_list) {
-            if (const TimeSpan cur_time = holder_base.GetAbsoluteWakeupTime(); cur_time < min_time) {
-                min_timeout_holder = std::addressof(holder_base);
-                min_time = cur_time;
+        /* NOTE: Only user objects (timer events) have wakeup times, so when we can, we only visit those. */
+        if (m_is_cache_valid) {
+            for (s32 i = 0; i < m_user_object_holder_count; ++i) {
+                if (const TimeSpan cur_time = m_cache->user_object_holders[i]->GetAbsoluteWakeupTime(); cur_time < min_time) {
+                    min_timeout_holder = m_cache->user_object_holders[i];
+                    min_time = cur_time;
+                }
+            }
+        } else {
+            for (MultiWaitHolderBase &holder_base : m_multi_wait_list) {
+                if (const TimeSpan cur_time = holder_base.GetAbsoluteWakeupTime(); cur_time < min_time) {
+                    min_timeout_holder = std::addressof(holder_base);
+                    min_time = cur_time;
+                }
             }
         }
 
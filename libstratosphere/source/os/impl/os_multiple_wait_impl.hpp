@@ -24,9 +24,18 @@
 
 namespace ams::os::impl {
 
+    /* Holders of a multi wait, split by kind, in list order, so that waiting doesn't need to visit every holder. */
+    struct MultiWaitHolderCacheImpl {
+        MultiWaitHolderBase *handle_holders[MultiWaitHandleCacheCount];
+        MultiWaitHolderBase *user_object_holders[MultiWaitUserObjectCacheCount];
+        NativeHandle handles[MultiWaitHandleCacheCount];
+    };
+
     class MultiWaitImpl {
         public:
-            static constexpr size_t MaximumHandleCount = MultiWaitTargetImpl::MaximumHandleCount;
+            static constexpr size_t MaximumHandleCount     = MultiWaitTargetImpl::MaximumHandleCount;
+            static constexpr size_t MaximumUserObjectCount = MultiWaitUserObjectCacheCount;
+            static_assert(MaximumHandleCount == MultiWaitHandleCacheCount);
             static constexpr s32 WaitInvalid   = -3;
             static constexpr s32 WaitCancelled = -2;
             static constexpr s32 WaitTimedOut  = -1;
@@ -37,11 +46,28 @@ namespace ams::os::impl {
             TimeSpan m_current_time;
             InternalCriticalSection m_cs_wait;
             MultiWaitTargetImpl m_target_impl;
+
+            /* Users which wait often may attach a holder cache; otherwise, waiting walks the holder list. */
+            /* NOTE: The cache is only usable while m_is_cache_valid; it's rebuilt lazily when a link overflows it. */
+            MultiWaitHolderCacheImpl *m_cache = nullptr;
+            s32 m_handle_holder_count = 0;
+            s32 m_user_object_holder_count = 0;
+            bool m_is_cache_valid = false;
         private:
             Result WaitAnyImpl(MultiWaitHolderBase **out, bool infinite, TimeSpan timeout, bool reply, NativeHandle reply_target);
             Result WaitAnyHandleImpl(MultiWaitHolderBase **out, bool infinite, TimeSpan timeout, bool reply, NativeHandle reply_target);
             s32                BuildHandleArray(NativeHandle out_handles[], MultiWaitHolderBase *out_objects[], s32 num);
 
+            void AddToCache(MultiWaitHolderBase &holder_base);
+            void RemoveFromCache(MultiWaitHolderBase &holder_base);
+            void RefreshCache();
+
+            void ClearCache() {
+                m_handle_holder_count      = 0;
+                m_user_object_holder_count = 0;
+                m_is_cache_valid           = m_cache != nullptr;
+            }
+
             MultiWaitHolderBase *LinkHoldersToObjectList();
             void                UnlinkHoldersFromObjectList();
 
@@ -74,6 +100,13 @@ namespace ams::os::impl {
                 return this->WaitAnyImpl(out, true, TimeSpan::FromNanoSeconds(std::numeric_limits<s64>::max()), true, reply_target);
             }
 
+            /* Cache management. */
+            void AttachCache(MultiWaitHolderCacheImpl *cache) {
+                m_cache          = cache;
+                m_is_cache_valid = false;
+                this->RefreshCache();
+            }
+
             /* List management. */
             bool IsEmpty() const {
                 return m_multi_wait_list.empty();
@@ -81,10 +114,12 @@ namespace ams::os::impl {
 
             void LinkMultiWaitHolder(MultiWaitHolderBase &holder_base) {
                 m_multi_wait_list.push_back(holder_base);
+                this->AddToCache(holder_base);
             }
 
             void UnlinkMultiWaitHolder(MultiWaitHolderBase &holder_base) {
                 m_multi_wait_list.erase(m_multi_wait_list.iterator_to(holder_base));
+                this->RemoveFromCache(holder_base);
             }
 
             void UnlinkAll() {
@@ -92,14 +127,17 @@ namespace ams::os::impl {
                     m_multi_wait_list.front().SetMultiWait(nullptr);
                     m_multi_wait_list.pop_front();
                 }
+                this->ClearCache();
             }
 
             void MoveAllFrom(MultiWaitImpl &other) {
                 /* Set ourselves as multi wait for all of the other's holders. */
                 for (auto &w : other.m_multi_wait_list) {
                     w.SetMultiWait(this);
+                    this->AddToCache(w);
                 }
                 m_multi_wait_list.splice(m_multi_wait_list.end(), other.m_multi_wait_list);
+                other.ClearCache();
             }
 
             /* Other. */
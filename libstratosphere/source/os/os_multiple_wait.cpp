@@ -54,6 +54,16 @@ namespace ams::os {
         util::DestroyAt(multi_wait->impl_storage);
     }
 
+    void AttachMultiWaitHolderCache(MultiWaitType *multi_wait, MultiWaitHolderCacheType *cache) {
+        auto &impl = GetMultiWaitImpl(multi_wait);
+
+        AMS_ASSERT(multi_wait->state == MultiWaitType::State_Initialized);
+
+        /* Initialize the cache storage, and let the multi wait use it. */
+        util::ConstructAt(cache->impl_storage);
+        impl.AttachCache(GetPointer(cache->impl_storage));
+    }
+
     MultiWaitHolderType *WaitAny(MultiWaitType *multi_wait) {
         auto &impl = GetMultiWaitImpl(multi_wait);
 
@@ -17,7 +17,33 @@
 
 namespace ams::sf::cmif {
 
-    Result impl::ServiceDispatchTableBase::ProcessMessageImpl(ServiceDispatchContext &ctx, const cmif::PointerAndSize &in_raw_data, const ServiceCommandMeta *entries, const size_t entry_count) const {
+    namespace {
+
+        ALWAYS_INLINE decltype(ServiceCommandMeta::handler) FindCommandHandler(const ServiceCommandMeta *entries, const u16 *sorted_indices, size_t entry_count, u32 cmd_id, hos::Version hos_version) {
+            /* Binary search for the first entry with the command id. */
+            size_t lo = 0, hi = entry_count;
+            while (lo < hi) {
+                const size_t mid = lo + (hi - lo) / 2;
+                if (entries[sorted_indices[mid]].cmd_id < cmd_id) {
+                    lo = mid + 1;
+                } else {
+                    hi = mid;
+                }
+            }
+
+            /* Check the entries for the command id in declaration order, as each may cover a different version range. */
+            for (size_t i = lo; i < entry_count && entries[sorted_indices[i]].cmd_id == cmd_id; ++i) {
+                if (entries[sorted_indices[i]].Matches(cmd_id, hos_version)) {
+                    return entries[sorted_indices[i]].GetHandler();
+                }
+            }
+
+            return nullptr;
+        }
+
+    }
+
+    Result impl::ServiceDispatchTableBase::ProcessMessageImpl(ServiceDispatchContext &ctx, const cmif::PointerAndSize &in_raw_data, const ServiceCommandMeta *entries, const u16 *sorted_indices, const size_t entry_count) const {
         /* Get versioning info. */
         const auto hos_version      = hos::GetVersion();
         const u32  max_cmif_version = hos_version >= hos::Version_5_0_0 ? 1 : 0;
@@ -30,13 +56,7 @@ namespace ams::sf::cmif {
         const u32 cmd_id = in_header->command_id;
 
         /* Find a handler. */
-        decltype(ServiceCommandMeta::handler) cmd_handler = nullptr;
-        for (size_t i = 0; i < entry_count; i++) {
-            if (entries[i].Matches(cmd_id, hos_version)) {
-                cmd_handler = entries[i].GetHandler();
-                break;
-            }
-        }
+        const auto cmd_handler = FindCommandHandler(entries, sorted_indices, entry_count, cmd_id, hos_version);
         R_UNLESS(cmd_handler != nullptr, sf::cmif::ResultUnknownCommandId());
 
         /* Invoke handler. */
@@ -60,7 +80,7 @@ namespace ams::sf::cmif {
         return ResultSuccess();
     }
 
-    Result impl::ServiceDispatchTableBase::ProcessMessageForMitmImpl(ServiceDispatchContext &ctx, const cmif::PointerAndSize &in_raw_data, const ServiceCommandMeta *entries, const size_t entry_count) const {
+    Result impl::ServiceDispatchTableBase::ProcessMessageForMitmImpl(ServiceDispatchContext &ctx, const cmif::PointerAndSize &in_raw_data, const ServiceCommandMeta *entries, const u16 *sorted_indices, const size_t entry_count) const {
         /* Get versioning info. */
         const auto hos_version      = hos::GetVersion();
         const u32  max_cmif_version = hos_version >= hos::Version_5_0_0 ? 1 : 0;
@@ -73,13 +93,7 @@ namespace ams::sf::cmif {
         const u32 cmd_id = in_header->command_id;
 
         /* Find a handler. */
-        decltype(ServiceCommandMeta::handler) cmd_handler = nullptr;
-        for (size_t i = 0; i < entry_count; i++) {
-            if (entries[i].Matches(cmd_id, hos_version)) {
-                cmd_handler = entries[i].GetHandler();
-                break;
-            }
-        }
+        const auto cmd_handler = FindCommandHandler(entries, sorted_indices, entry_count, cmd_id, hos_version);
 
         /* If we didn't find a handler, forward the request. */
         if (cmd_handler == nullptr) {
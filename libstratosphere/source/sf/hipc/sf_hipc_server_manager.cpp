@@ -42,32 +42,244 @@ namespace ams::sf::hipc {
     }
 
     void ServerManagerBase::LinkToDeferredList(os::MultiWaitHolderType *holder) {
-        std::scoped_lock lk(m_deferred_list_mutex);
-        os::LinkMultiWaitHolder(std::addressof(m_deferred_list), holder);
-        m_notify_event.Signal();
+        /* Holders stay with the thread which last processed them. */
+        if (ProcessingPartition *partition = this->FindOwnedProcessingPartition(); partition != nullptr) {
+            this->LinkToDeferredList(partition, holder);
+            return;
+        }
+
+        if (m_partition_count > 1) {
+            /* Anything else is spread across the partitions which have an owner, so that it is never linked to a partition nobody waits on. */
+            /* Ownership can't change while we hold the partition mutex; see ReleaseProcessingPartition. */
+            std::scoped_lock lk(m_partition_mutex);
+            this->LinkToDeferredList(this->SelectSharedProcessingPartition(), holder);
+        } else {
+            this->LinkToDeferredList(std::addressof(m_partitions[0]), holder);
+        }
     }
 
-    void ServerManagerBase::LinkDeferred() {
-        std::scoped_lock lk(m_deferred_list_mutex);
-        os::MoveAllMultiWaitHolder(std::addressof(m_multi_wait), std::addressof(m_deferred_list));
+    void ServerManagerBase::LinkToDeferredList(ProcessingPartition *partition, os::MultiWaitHolderType *holder) {
+        std::scoped_lock lk(partition->deferred_list_mutex);
+        os::LinkMultiWaitHolder(std::addressof(partition->deferred_list), holder);
+        partition->notify_event.Signal();
     }
 
-    os::MultiWaitHolderType *ServerManagerBase::WaitSignaled() {
-        std::scoped_lock lk(m_selection_mutex);
+    void ServerManagerBase::LinkDeferred(ProcessingPartition *partition) {
+        std::scoped_lock lk(partition->deferred_list_mutex);
+        os::MoveAllMultiWaitHolder(std::addressof(partition->multi_wait), std::addressof(partition->deferred_list));
+    }
+
+    ServerManagerBase::ProcessingPartition *ServerManagerBase::AcquireProcessingPartition() {
+        /* With a single partition, every thread shares it. */
+        if (m_partition_count == 1) {
+            return std::addressof(m_partitions[0]);
+        }
+
+        std::scoped_lock lk(m_partition_mutex);
+
+        /* Take ownership of an unowned partition. */
+        for (s32 i = 0; i < m_partition_count; ++i) {
+            if (m_partitions[i].owner_thread == nullptr) {
+                m_partitions[i].owner_thread = os::GetCurrentThread();
+                return std::addressof(m_partitions[i]);
+            }
+        }
+
+        /* If every partition is owned, share the first one. */
+        return std::addressof(m_partitions[0]);
+    }
+
+    void ServerManagerBase::ReleaseProcessingPartition(ProcessingPartition *partition) {
+        std::scoped_lock lk(m_partition_mutex);
+
+        if (partition->owner_thread == os::GetCurrentThread()) {
+            this->SetProcessingPartitionBusy(partition, false);
+            partition->owner_thread = nullptr;
+
+            /* Nobody waits on an unowned partition, so hand everything linked to it to a partition which is still waited on. */
+            ProcessingPartition *fallback = this->FindFallbackProcessingPartition(partition);
+            if (fallback != partition) {
+                std::scoped_lock slk(partition->selection_mutex);
+                this->LinkDeferred(partition);
+
+                os::UnlinkMultiWaitHolder(std::addressof(partition->request_stop_event_holder));
+                os::UnlinkMultiWaitHolder(std::addressof(partition->notify_event_holder));
+                {
+                    std::scoped_lock dlk(fallback->deferred_list_mutex);
+                    os::MoveAllMultiWaitHolder(std::addressof(fallback->deferred_list), std::addressof(partition->multi_wait));
+                    fallback->notify_event.Signal();
+                }
+                os::LinkMultiWaitHolder(std::addressof(partition->multi_wait), std::addressof(partition->request_stop_event_holder));
+                os::LinkMultiWaitHolder(std::addressof(partition->multi_wait), std::addressof(partition->notify_event_holder));
+            }
+        }
+    }
+
+    ServerManagerBase::ProcessingPartition *ServerManagerBase::FindOwnedProcessingPartition() {
+        if (m_partition_count > 1) {
+            const auto *cur_thread = os::GetCurrentThread();
+            for (s32 i = 0; i < m_partition_count; ++i) {
+                if (m_partitions[i].owner_thread == cur_thread) {
+                    return std::addressof(m_partitions[i]);
+                }
+            }
+        }
+
+        return nullptr;
+    }
+
+    ServerManagerBase::ProcessingPartition *ServerManagerBase::SelectSharedProcessingPartition() {
+        s32 owned_count = 0;
+        for (s32 i = 0; i < m_partition_count; ++i) {
+            if (m_partitions[i].owner_thread != nullptr) {
+                ++owned_count;
+            }
+        }
+
+        /* If no partition has an owner, use the first, which non-owning threads wait on. */
+        if (owned_count > 0) {
+            s32 target = static_cast<s32>(m_next_partition_index++ % owned_count);
+            for (s32 i = 0; i < m_partition_count; ++i) {
+                if (m_partitions[i].owner_thread != nullptr && (target--) == 0) {
+                    return std::addressof(m_partitions[i]);
+                }
+            }
+        }
+
+        return std::addressof(m_partitions[0]);
+    }
+
+    ServerManagerBase::ProcessingPartition *ServerManagerBase::FindFallbackProcessingPartition(const ProcessingPartition *exclude) {
+        /* Prefer a partition which still has an owner, and otherwise use the first, which non-owning threads wait on. */
+        for (s32 i = 0; i < m_partition_count; ++i) {
+            if (std::addressof(m_partitions[i]) != exclude && m_partitions[i].owner_thread != nullptr) {
+                return std::addressof(m_partitions[i]);
+            }
+        }
+
+        return std::addressof(m_partitions[0]);
+    }
+
+    void ServerManagerBase::SetProcessingPartitionBusy(ProcessingPartition *partition, bool busy) {
+        if (partition->is_busy != busy) {
+            partition->is_busy = busy;
+            if (busy) {
+                ++m_busy_partition_count;
+            } else {
+                --m_busy_partition_count;
+            }
+        }
+    }
+
+    void ServerManagerBase::NotifyIdleProcessingPartition(ProcessingPartition *partition) {
+        /* Wake one idle thread, so that it can take work from us while we're busy. */
+        for (s32 i = 0; i < m_partition_count; ++i) {
+            auto &idle = m_partitions[i];
+            if (std::addressof(idle) != partition && idle.owner_thread != nullptr && !idle.is_busy) {
+                idle.notify_event.Signal();
+                break;
+            }
+        }
+    }
+
+    os::MultiWaitHolderType *ServerManagerBase::TryStealSignaledSession(ProcessingPartition *partition) {
+        for (s32 i = 0; i < m_partition_count; ++i) {
+            /* Only take from threads which are busy processing, and so aren't waiting on their own partition. */
+            auto &busy = m_partitions[i];
+            if (std::addressof(busy) == partition || !busy.is_busy) {
+                continue;
+            }
+
+            /* Never wait on another thread's partition; if its owner is selecting, it doesn't need our help. */
+            if (!busy.selection_mutex.TryLock()) {
+                continue;
+            }
+            ON_SCOPE_EXIT { busy.selection_mutex.Unlock(); };
+
+            /* Take a signaled session, if there is one. */
+            this->LinkDeferred(std::addressof(busy));
+
+            /* Signaled holders which aren't sessions are left to the owner, so set them aside while we look past them. */
+            os::MultiWaitType skipped;
+            os::InitializeMultiWait(std::addressof(skipped));
+            ON_SCOPE_EXIT {
+                os::MoveAllMultiWaitHolder(std::addressof(busy.multi_wait), std::addressof(skipped));
+                os::FinalizeMultiWait(std::addressof(skipped));
+            };
+
+            while (auto *selected = os::TryWaitAny(std::addressof(busy.multi_wait))) {
+                os::UnlinkMultiWaitHolder(selected);
+                if (static_cast<UserDataTag>(os::GetMultiWaitHolderUserData(selected)) == UserDataTag::Session) {
+                    return selected;
+                }
+
+                os::LinkMultiWaitHolder(std::addressof(skipped), selected);
+            }
+        }
+
+        return nullptr;
+    }
+
+    os::MultiWaitHolderType *ServerManagerBase::WaitSignaledImpl(ProcessingPartition *partition) {
+        /* Only the owner of a partition takes part in work stealing. */
+        const bool is_owner = partition->owner_thread == os::GetCurrentThread();
+        if (is_owner) {
+            this->SetProcessingPartitionBusy(partition, false);
+        }
+
+        std::scoped_lock lk(partition->selection_mutex);
         while (true) {
-            this->LinkDeferred();
-            auto selected = os::WaitAny(std::addressof(m_multi_wait));
-            if (selected == std::addressof(m_request_stop_event_holder)) {
+            this->LinkDeferred(partition);
+
+            os::MultiWaitHolderType *selected = nullptr;
+            if (is_owner && m_busy_partition_count > 0) {
+                /* Other threads are busy, so prefer our own work, then theirs. */
+                selected = os::TryWaitAny(std::addressof(partition->multi_wait));
+                if (selected == nullptr) {
+                    if (selected = this->TryStealSignaledSession(partition); selected != nullptr) {
+                        this->SetProcessingPartitionBusy(partition, true);
+                        return selected;
+                    }
+                }
+            }
+
+            /* Otherwise, block until we have work, or until a busy thread notifies us that it has a backlog. */
+            if (selected == nullptr) {
+                selected = os::WaitAny(std::addressof(partition->multi_wait));
+            }
+
+            if (selected == std::addressof(partition->request_stop_event_holder)) {
                 return nullptr;
-            } else if (selected == std::addressof(m_notify_event_holder)) {
-                m_notify_event.Clear();
+            } else if (selected == std::addressof(partition->notify_event_holder)) {
+                partition->notify_event.Clear();
             } else {
                 os::UnlinkMultiWaitHolder(selected);
+
+                if (is_owner) {
+                    this->SetProcessingPartitionBusy(partition, true);
+
+                    /* If we've more work waiting than we can do right now, let an idle thread know. */
+                    if (m_busy_partition_count < m_partition_count) {
+                        if (auto *pending = os::TryWaitAny(std::addressof(partition->multi_wait)); pending != nullptr && pending != std::addressof(partition->request_stop_event_holder) && pending != std::addressof(partition->notify_event_holder)) {
+                            this->NotifyIdleProcessingPartition(partition);
+                        }
+                    }
+                }
+
                 return selected;
             }
         }
     }
 
+    os::MultiWaitHolderType *ServerManagerBase::WaitSignaled() {
+        ProcessingPartition *partition = this->FindOwnedProcessingPartition();
+        if (partition == nullptr) {
+            partition = std::addressof(m_partitions[0]);
+        }
+
+        return this->WaitSignaledImpl(partition);
+    }
+
     void ServerManagerBase::ResumeProcessing() {
         m_request_stop_event.Clear();
     }
@@ -166,8 +378,8 @@ namespace ams::sf::hipc {
         }
     }
 
-    bool ServerManagerBase::WaitAndProcessImpl() {
-        if (auto *signaled_holder = this->WaitSignaled(); signaled_holder != nullptr) {
+    bool ServerManagerBase::WaitAndProcessImpl(ProcessingPartition *partition) {
+        if (auto *signaled_holder = this->WaitSignaledImpl(partition); signaled_holder != nullptr) {
             R_ABORT_UNLESS(this->Process(signaled_holder));
             return true;
         } else {
@@ -176,11 +388,19 @@ namespace ams::sf::hipc {
     }
 
     void ServerManagerBase::WaitAndProcess() {
-        this->WaitAndProcessImpl();
+        ProcessingPartition *partition = this->FindOwnedProcessingPartition();
+        if (partition == nullptr) {
+            partition = std::addressof(m_partitions[0]);
+        }
+
+        this->WaitAndProcessImpl(partition);
     }
 
     void ServerManagerBase::LoopProcess() {
-        while (this->WaitAndProcessImpl()) {
+        ProcessingPartition *partition = this->AcquireProcessingPartition();
+        ON_SCOPE_EXIT { this->ReleaseProcessingPartition(partition); };
+
+        while (this->WaitAndProcessImpl(partition)) {
             /* ... */
         }
     }
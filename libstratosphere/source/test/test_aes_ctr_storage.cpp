@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) Atmosphère-NX
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms and conditions of the GNU General Public License,
+ * version 2, as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <stratosphere.hpp>
+
+/* TODO: Define to enable tests? */
+#if 0
+#include <cstdio>
+
+namespace ams::test {
+
+    namespace {
+
+        constexpr size_t StorageSize = 4_MB;
+
+        constexpr s32    WorkerThreadCount     = 2;
+        constexpr size_t WorkerThreadStackSize = 16_KB;
+
+        constexpr u8 Key[fssystem::AesCtrStorage::KeySize] = { 0x2B, 0x7E, 0x15, 0x16, 0x28, 0xAE, 0xD2, 0xA6, 0xAB, 0xF7, 0x15, 0x88, 0x09, 0xCF, 0x4F, 0x3C };
+        constexpr u8 Iv[fssystem::AesCtrStorage::IvSize]   = { 0xF0, 0xF1, 0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+
+        alignas(os::MemoryPageSize) u8 g_storage_buffer[StorageSize];
+        alignas(os::MemoryPageSize) u8 g_serial_buffer[StorageSize];
+        alignas(os::MemoryPageSize) u8 g_parallel_buffer[StorageSize];
+
+        alignas(os::ThreadStackAlignment) u8 g_worker_thread_stack[WorkerThreadCount * WorkerThreadStackSize];
+
+        void InitializeStorageBuffer() {
+            u32 seed = 0x12345678;
+            for (size_t i = 0; i < StorageSize; ++i) {
+                seed = seed * 1103515245 + 12345;
+                g_storage_buffer[i] = static_cast<u8>(seed >> 16);
+            }
+        }
+
+        double MeasureReadThroughput(fssystem::AesCtrStorage &storage, void *buffer, size_t read_size) {
+            constexpr auto Duration = TimeSpan::FromSeconds(1);
+
+            /* Read the whole storage repeatedly, read_size bytes at a time. */
+            size_t total_size = 0;
+            s64 offset = 0;
+
+            const auto start = os::GetSystemTick().ToTimeSpan();
+            auto elapsed = TimeSpan(0);
+            while (elapsed < Duration) {
+                R_ABORT_UNLESS(storage.Read(offset, buffer, read_size));
+
+                total_size += read_size;
+                offset      = (offset + read_size) % StorageSize;
+                elapsed     = os::GetSystemTick().ToTimeSpan() - start;
+            }
+
+            return static_cast<double>(total_size) / 1_MB / (static_cast<double>(elapsed.GetNanoSeconds()) / TimeSpan::FromSeconds(1).GetNanoSeconds());
+        }
+
+    }
+
+    void BenchmarkAesCtrStorage() {
+        InitializeStorageBuffer();
+
+        /* We'll switch between having and not having a thread pool registered, so restore the original when we're done. */
+        auto * const original_thread_pool = fssystem::GetRegisteredThreadPool();
+        ON_SCOPE_EXIT { fssystem::RegisterThreadPool(original_thread_pool); };
+
+        fs::MemoryStorage base_storage(g_storage_buffer, StorageSize);
+        fssystem::AesCtrStorage storage(std::addressof(base_storage), Key, sizeof(Key), Iv, sizeof(Iv));
+
+        fssystem::ThreadPool thread_pool;
+        R_ABORT_UNLESS(thread_pool.Initialize(WorkerThreadCount, g_worker_thread_stack, sizeof(g_worker_thread_stack), os::DefaultThreadPriority));
+
+        constexpr size_t ReadSizes[] = { 16_KB, 256_KB, 1_MB, 4_MB };
+        for (const size_t read_size : ReadSizes) {
+            /* Check that both paths decrypt identically. */
+            fssystem::RegisterThreadPool(nullptr);
+            R_ABORT_UNLESS(storage.Read(0, g_serial_buffer, read_size));
+
+            fssystem::RegisterThreadPool(std::addressof(thread_pool));
+            R_ABORT_UNLESS(storage.Read(0, g_parallel_buffer, read_size));
+
+            AMS_ABORT_UNLESS(std::memcmp(g_serial_buffer, g_parallel_buffer, read_size) == 0);
+
+            /* Measure each path. */
+            fssystem::RegisterThreadPool(nullptr);
+            const double serial_mb_per_sec = MeasureReadThroughput(storage, g_serial_buffer, read_size);
+
+            fssystem::RegisterThreadPool(std::addressof(thread_pool));
+            const double parallel_mb_per_sec = MeasureReadThroughput(storage, g_parallel_buffer, read_size);
+
+            std::printf("AesCtrStorage %zu KiB reads: single-threaded %.1f MB/s, parallel %.1f MB/s\n", read_size / 1_KB, serial_mb_per_sec, parallel_mb_per_sec);
+        }
+    }
+
+}
+
+#endif
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) Atmosphère-NX
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms and conditions of the GNU General Public License,
+ * version 2, as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <stratosphere.hpp>
+
+/* TODO: Define to enable tests? */
+#if 0
+#include <cstdio>
+
+namespace ams::test {
+
+    namespace {
+
+        constexpr size_t HeapSize      = 1_MB;
+        constexpr size_t BlockSize     = 16_KB;
+        constexpr size_t ShardSize     = 256_KB;
+        constexpr s32    ShardCount    = 2;
+        constexpr s32    MaxCacheCount = 1024;
+
+        constexpr s32    ThreadCountMax  = 4;
+        constexpr size_t ThreadStackSize = 16_KB;
+
+        constexpr s32 IterationCount = 100000;
+
+        alignas(os::MemoryPageSize) u8 g_heap[HeapSize];
+
+        alignas(os::ThreadStackAlignment) u8 g_thread_stacks[ThreadCountMax][ThreadStackSize];
+        os::ThreadType g_threads[ThreadCountMax];
+
+        void StressThreadFunction(void *arg) {
+            auto * const buffer_manager = static_cast<fssystem::IBufferManager *>(arg);
+
+            /* Mimic a cache user: allocate a block, publish it, and later take it back if it hasn't been evicted. */
+            constexpr size_t AllocationSizes[] = { BlockSize, 2 * BlockSize, 4 * BlockSize };
+
+            u32 seed = static_cast<u32>(os::GetThreadId(os::GetCurrentThread()));
+            fssystem::IBufferManager::CacheHandle handle = 0;
+            size_t handle_size = 0;
+
+            for (s32 i = 0; i < IterationCount; ++i) {
+                seed = seed * 1103515245 + 12345;
+                const size_t size = AllocationSizes[(seed >> 16) % util::size(AllocationSizes)];
+
+                /* Take back our previous buffer, if it's still cached. */
+                if (handle_size != 0) {
+                    if (const auto range = buffer_manager->AcquireCache(handle); range.first != 0) {
+                        buffer_manager->DeallocateBuffer(range.first, range.second);
+                    }
+                    handle_size = 0;
+                }
+
+                /* Allocate a new buffer, and publish it. */
+                if (const auto range = buffer_manager->AllocateBuffer(size); range.first != 0) {
+                    handle      = buffer_manager->RegisterCache(range.first, range.second, fssystem::IBufferManager::BufferAttribute());
+                    handle_size = range.second;
+                }
+            }
+
+            /* Release whatever we still hold. */
+            if (handle_size != 0) {
+                if (const auto range = buffer_manager->AcquireCache(handle); range.first != 0) {
+                    buffer_manager->DeallocateBuffer(range.first, range.second);
+                }
+            }
+        }
+
+        void MeasureStress(const char *name, fssystem::IBufferManager *buffer_manager, s32 thread_count) {
+            const auto start = os::GetSystemTick().ToTimeSpan();
+
+            for (s32 i = 0; i < thread_count; ++i) {
+                R_ABORT_UNLESS(os::CreateThread(g_threads + i, StressThreadFunction, buffer_manager, g_thread_stacks[i], ThreadStackSize, os::DefaultThreadPriority, i % 4));
+                os::StartThread(g_threads + i);
+            }
+            for (s32 i = 0; i < thread_count; ++i) {
+                os::WaitThread(g_threads + i);
+                os::DestroyThread(g_threads + i);
+            }
+
+            const auto elapsed = os::GetSystemTick().ToTimeSpan() - start;
+            const double ops_per_sec = static_cast<double>(thread_count) * IterationCount / (static_cast<double>(elapsed.GetNanoSeconds()) / TimeSpan::FromSeconds(1).GetNanoSeconds());
+
+            std::printf("%s, %d threads: %.0f allocations/s, %zu retries\n", name, thread_count, ops_per_sec, buffer_manager->GetRetriedCount());
+        }
+
+    }
+
+    void BenchmarkFileSystemBufferManager() {
+        constexpr s32 ThreadCounts[] = { 1, 2, 4 };
+
+        for (const s32 thread_count : ThreadCounts) {
+            /* Measure a single buffer manager over the whole heap. */
+            {
+                fssystem::FileSystemBufferManager buffer_manager;
+                R_ABORT_UNLESS(buffer_manager.Initialize(MaxCacheCount, reinterpret_cast<uintptr_t>(g_heap), HeapSize, BlockSize));
+
+                MeasureStress("FileSystemBufferManager", std::addressof(buffer_manager), thread_count);
+                buffer_manager.Finalize();
+            }
+
+            /* Measure the sharded buffer manager, configured as the fs proxy configures it. */
+            {
+                fssystem::ShardedFileSystemBufferManager buffer_manager;
+                R_ABORT_UNLESS(buffer_manager.Initialize(ShardCount, MaxCacheCount, reinterpret_cast<uintptr_t>(g_heap), HeapSize, BlockSize, ShardSize));
+
+                MeasureStress("ShardedFileSystemBufferManager", std::addressof(buffer_manager), thread_count);
+            }
+        }
+    }
+
+}
+
+#endif
@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) Atmosphère-NX
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms and conditions of the GNU General Public License,
+ * version 2, as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <stratosphere.hpp>
+
+/* TODO: Define to enable tests? */
+#if 0
+#include <cstdio>
+#include <cstdlib>
+
+namespace ams::test {
+
+    namespace {
+
+        constexpr size_t NodeSize  = fssystem::IndirectStorage::NodeSize;
+        constexpr s32 EntryCount   = 4096;
+        constexpr s64 EntrySpan    = 512;
+        constexpr s64 VirtualSize  = EntryCount * EntrySpan;
+        constexpr s64 DataSize     = VirtualSize / fssystem::IndirectStorage::StorageCount;
+
+        constexpr s32 EntryCountPerSet = static_cast<s32>((NodeSize - sizeof(fssystem::BucketTree::NodeHeader)) / sizeof(fssystem::IndirectStorage::Entry));
+        constexpr s32 EntrySetCount    = util::DivideUp(EntryCount, EntryCountPerSet);
+        static_assert(EntrySetCount <= static_cast<s32>((NodeSize - sizeof(fssystem::BucketTree::NodeHeader)) / sizeof(s64)));
+
+        constexpr s64 NodeStorageSize  = fssystem::IndirectStorage::QueryNodeStorageSize(EntryCount);
+        constexpr s64 EntryStorageSize = fssystem::IndirectStorage::QueryEntryStorageSize(EntryCount);
+
+        constexpr s32 ReadCount = 100000;
+        constexpr size_t ReadSize = 256;
+
+        alignas(8) u8 g_node_storage_buffer[NodeStorageSize];
+        alignas(8) u8 g_entry_storage_buffer[EntryStorageSize];
+        u8 g_data_storage_buffers[fssystem::IndirectStorage::StorageCount][DataSize];
+
+        class MallocMemoryResource : public MemoryResource {
+            protected:
+                virtual void *AllocateImpl(size_t size, size_t alignment) override {
+                    AMS_UNUSED(alignment);
+                    return std::malloc(size);
+                }
+
+                virtual void DeallocateImpl(void *buffer, size_t size, size_t alignment) override {
+                    AMS_UNUSED(size, alignment);
+                    return std::free(buffer);
+                }
+
+                virtual bool IsEqualImpl(const MemoryResource &resource) const override {
+                    return this == std::addressof(resource);
+                }
+        };
+
+        /* Counts reads made to an underlying table storage. */
+        class CountingStorage : public fs::IStorage {
+            private:
+                fs::IStorage *m_base_storage;
+                s64 m_read_count;
+            public:
+                explicit CountingStorage(fs::IStorage *base) : m_base_storage(base), m_read_count(0) { /* ... */ }
+
+                s64 GetReadCount() const { return m_read_count; }
+                void ResetReadCount() { m_read_count = 0; }
+
+                virtual Result Read(s64 offset, void *buffer, size_t size) override {
+                    ++m_read_count;
+                    return m_base_storage->Read(offset, buffer, size);
+                }
+
+                virtual Result Write(s64 offset, const void *buffer, size_t size) override { return m_base_storage->Write(offset, buffer, size); }
+                virtual Result Flush() override { return m_base_storage->Flush(); }
+                virtual Result SetSize(s64 size) override { return m_base_storage->SetSize(size); }
+                virtual Result GetSize(s64 *out) override { return m_base_storage->GetSize(out); }
+
+                virtual Result OperateRange(void *dst, size_t dst_size, fs::OperationId op_id, s64 offset, s64 size, const void *src, size_t src_size) override {
+                    return m_base_storage->OperateRange(dst, dst_size, op_id, offset, size, src, src_size);
+                }
+        };
+
+        /* Lays out a table with a single L1 node, where entries alternate between the two data storages. */
+        void FormatTable() {
+            std::memset(g_node_storage_buffer, 0, sizeof(g_node_storage_buffer));
+            std::memset(g_entry_storage_buffer, 0, sizeof(g_entry_storage_buffer));
+
+            auto *l1 = reinterpret_cast<fssystem::BucketTree::NodeHeader *>(g_node_storage_buffer);
+            l1->index  = 0;
+            l1->count  = EntrySetCount;
+            l1->offset = VirtualSize;
+
+            auto *l1_offsets = reinterpret_cast<s64 *>(l1 + 1);
+            for (s32 set = 0; set < EntrySetCount; ++set) {
+                const s32 begin = set * EntryCountPerSet;
+                const s32 end   = std::min(begin + EntryCountPerSet, EntryCount);
+
+                l1_offsets[set] = begin * EntrySpan;
+
+                auto *header = reinterpret_cast<fssystem::BucketTree::NodeHeader *>(g_entry_storage_buffer + set * NodeSize);
+                header->index  = set;
+                header->count  = end - begin;
+                header->offset = end * EntrySpan;
+
+                auto *entries = reinterpret_cast<fssystem::IndirectStorage::Entry *>(header + 1);
+                for (s32 i = begin; i < end; ++i) {
+                    auto &entry = entries[i - begin];
+                    entry.SetVirtualOffset(i * EntrySpan);
+                    entry.SetPhysicalOffset((i / 2) * EntrySpan);
+                    entry.storage_index = i % 2;
+                }
+            }
+        }
+
+        void MeasureReads(const char *name, MemoryResource *allocator, CountingStorage &node_storage, CountingStorage &entry_storage, fs::IStorage &data_storage_0, fs::IStorage &data_storage_1, bool sequential) {
+            /* Use a freshly initialized storage, so that no nodes are cached from a previous run. */
+            fssystem::IndirectStorage storage;
+            R_ABORT_UNLESS(storage.Initialize(allocator, fs::SubStorage(std::addressof(node_storage), 0, NodeStorageSize), fs::SubStorage(std::addressof(entry_storage), 0, EntryStorageSize), EntryCount));
+            storage.SetStorage(0, std::addressof(data_storage_0), 0, DataSize);
+            storage.SetStorage(1, std::addressof(data_storage_1), 0, DataSize);
+
+            node_storage.ResetReadCount();
+            entry_storage.ResetReadCount();
+
+            u8 buffer[ReadSize];
+            u32 seed = 0x12345678;
+            s64 offset = 0;
+
+            const auto start = os::GetSystemTick().ToTimeSpan();
+            for (s32 i = 0; i < ReadCount; ++i) {
+                if (sequential) {
+                    offset = (offset + ReadSize) % VirtualSize;
+                } else {
+                    seed   = seed * 1103515245 + 12345;
+                    offset = util::AlignDown(static_cast<s64>(seed >> 8) % VirtualSize, ReadSize);
+                }
+
+                R_ABORT_UNLESS(storage.Read(offset, buffer, ReadSize));
+            }
+            const auto elapsed = os::GetSystemTick().ToTimeSpan() - start;
+
+            const s64 table_reads = node_storage.GetReadCount() + entry_storage.GetReadCount();
+            std::printf("IndirectStorage %s %zu-byte reads: %.3f table storage reads/read (%lld total), %.2f us/read\n", name, ReadSize, static_cast<double>(table_reads) / ReadCount, static_cast<long long>(table_reads), static_cast<double>(elapsed.GetNanoSeconds()) / ReadCount / 1000.0);
+        }
+
+    }
+
+    void BenchmarkIndirectStorageTableReads() {
+        FormatTable();
+
+        MallocMemoryResource allocator;
+
+        fs::MemoryStorage node_memory_storage(g_node_storage_buffer, sizeof(g_node_storage_buffer));
+        fs::MemoryStorage entry_memory_storage(g_entry_storage_buffer, sizeof(g_entry_storage_buffer));
+        CountingStorage node_storage(std::addressof(node_memory_storage));
+        CountingStorage entry_storage(std::addressof(entry_memory_storage));
+
+        fs::MemoryStorage data_storage_0(g_data_storage_buffers[0], DataSize);
+        fs::MemoryStorage data_storage_1(g_data_storage_buffers[1], DataSize);
+
+        MeasureReads("sequential", std::addressof(allocator), node_storage, entry_storage, data_storage_0, data_storage_1, true);
+        MeasureReads("random", std::addressof(allocator), node_storage, entry_storage, data_storage_0, data_storage_1, false);
+    }
+
+}
+
+#endif
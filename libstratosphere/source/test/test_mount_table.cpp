@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) Atmosphère-NX
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms and conditions of the GNU General Public License,
+ * version 2, as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <stratosphere.hpp>
+#include "../fs/fsa/fs_mount_table.hpp"
+
+/* TODO: Define to enable tests? */
+#if 0
+#include <cstdio>
+
+namespace ams::test {
+
+    namespace {
+
+        constexpr s32 MountCountMax = 64;
+        constexpr s32 LookupCount   = 1000000;
+
+        class EmptyFileSystem : public fs::fsa::IFileSystem, public fs::impl::Newable {
+            private:
+                virtual Result DoCreateFile(const char *path, s64 size, int flags) override { AMS_UNUSED(path, size, flags); return fs::ResultNotImplemented(); }
+                virtual Result DoDeleteFile(const char *path) override { AMS_UNUSED(path); return fs::ResultNotImplemented(); }
+                virtual Result DoCreateDirectory(const char *path) override { AMS_UNUSED(path); return fs::ResultNotImplemented(); }
+                virtual Result DoDeleteDirectory(const char *path) override { AMS_UNUSED(path); return fs::ResultNotImplemented(); }
+                virtual Result DoDeleteDirectoryRecursively(const char *path) override { AMS_UNUSED(path); return fs::ResultNotImplemented(); }
+                virtual Result DoRenameFile(const char *old_path, const char *new_path) override { AMS_UNUSED(old_path, new_path); return fs::ResultNotImplemented(); }
+                virtual Result DoRenameDirectory(const char *old_path, const char *new_path) override { AMS_UNUSED(old_path, new_path); return fs::ResultNotImplemented(); }
+                virtual Result DoGetEntryType(fs::DirectoryEntryType *out, const char *path) override { AMS_UNUSED(out, path); return fs::ResultNotImplemented(); }
+                virtual Result DoOpenFile(std::unique_ptr<fs::fsa::IFile> *out_file, const char *path, fs::OpenMode mode) override { AMS_UNUSED(out_file, path, mode); return fs::ResultNotImplemented(); }
+                virtual Result DoOpenDirectory(std::unique_ptr<fs::fsa::IDirectory> *out_dir, const char *path, fs::OpenDirectoryMode mode) override { AMS_UNUSED(out_dir, path, mode); return fs::ResultNotImplemented(); }
+                virtual Result DoCommit() override { return fs::ResultNotImplemented(); }
+                virtual Result DoCleanDirectoryRecursively(const char *path) override { AMS_UNUSED(path); return fs::ResultNotImplemented(); }
+        };
+
+        char g_mount_names[MountCountMax][fs::MountNameLengthMax + 1];
+
+        void MeasureLookup(s32 mount_count) {
+            fs::impl::MountTable table;
+
+            /* Mount our file systems. */
+            for (s32 i = 0; i < mount_count; ++i) {
+                util::SNPrintf(g_mount_names[i], sizeof(g_mount_names[i]), "mount%02d", i);
+
+                std::unique_ptr<fs::fsa::IFileSystem> fs(new EmptyFileSystem());
+                AMS_ABORT_UNLESS(fs != nullptr);
+
+                std::unique_ptr<fs::impl::FileSystemAccessor> accessor(new fs::impl::FileSystemAccessor(g_mount_names[i], std::move(fs)));
+                AMS_ABORT_UNLESS(accessor != nullptr);
+
+                R_ABORT_UNLESS(table.Mount(std::move(accessor)));
+            }
+
+            /* Look up every mount in turn. */
+            fs::impl::FileSystemAccessor *accessor = nullptr;
+            const auto start = os::GetSystemTick().ToTimeSpan();
+            for (s32 i = 0; i < LookupCount; ++i) {
+                R_ABORT_UNLESS(table.Find(std::addressof(accessor), g_mount_names[i % mount_count]));
+            }
+            const auto hit_elapsed = os::GetSystemTick().ToTimeSpan() - start;
+
+            /* Look up a name that isn't mounted, which must examine every candidate. */
+            const auto miss_start = os::GetSystemTick().ToTimeSpan();
+            for (s32 i = 0; i < LookupCount; ++i) {
+                AMS_ABORT_UNLESS(fs::ResultNotMounted::Includes(table.Find(std::addressof(accessor), "missing")));
+            }
+            const auto miss_elapsed = os::GetSystemTick().ToTimeSpan() - miss_start;
+
+            std::printf("MountTable, %2d mounts: %.1f ns/hit, %.1f ns/miss\n", mount_count, static_cast<double>(hit_elapsed.GetNanoSeconds()) / LookupCount, static_cast<double>(miss_elapsed.GetNanoSeconds()) / LookupCount);
+
+            /* Unmount everything. */
+            for (s32 i = 0; i < mount_count; ++i) {
+                table.Unmount(g_mount_names[i]);
+            }
+        }
+
+    }
+
+    void BenchmarkMountTable() {
+        /* NOTE: Counts past the index's 48-mount cap exercise the list fallback. */
+        constexpr s32 MountCounts[] = { 1, 4, 8, 16, 32, 48, 64 };
+        for (const s32 mount_count : MountCounts) {
+            MeasureLookup(mount_count);
+        }
+    }
+
+}
+
+#endif
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) Atmosphère-NX
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms and conditions of the GNU General Public License,
+ * version 2, as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <stratosphere.hpp>
+
+/* TODO: Define to enable tests? */
+#if 0
+#include <cstdio>
+
+namespace ams::test {
+
+    namespace {
+
+        constexpr s32 HolderCountMax = 64;
+        constexpr s32 IterationCount = 100000;
+
+        os::SystemEventType g_events[HolderCountMax];
+        os::MultiWaitHolderType g_holders[HolderCountMax];
+
+        os::MultiWaitType g_multi_wait;
+        os::MultiWaitHolderCacheType g_multi_wait_cache;
+
+        void MeasureMultiWait(s32 holder_count, bool use_cache) {
+            /* Set up a multi wait over kernel events, of which only the last is signaled. */
+            os::InitializeMultiWait(std::addressof(g_multi_wait));
+            if (use_cache) {
+                os::AttachMultiWaitHolderCache(std::addressof(g_multi_wait), std::addressof(g_multi_wait_cache));
+            }
+
+            for (s32 i = 0; i < holder_count; ++i) {
+                R_ABORT_UNLESS(os::CreateSystemEvent(std::addressof(g_events[i]), os::EventClearMode_ManualClear, true));
+                os::InitializeMultiWaitHolder(std::addressof(g_holders[i]), std::addressof(g_events[i]));
+                os::LinkMultiWaitHolder(std::addressof(g_multi_wait), std::addressof(g_holders[i]));
+            }
+            os::SignalSystemEvent(std::addressof(g_events[holder_count - 1]));
+
+            ON_SCOPE_EXIT {
+                os::UnlinkAllMultiWaitHolder(std::addressof(g_multi_wait));
+                for (s32 i = 0; i < holder_count; ++i) {
+                    os::FinalizeMultiWaitHolder(std::addressof(g_holders[i]));
+                    os::DestroySystemEvent(std::addressof(g_events[i]));
+                }
+                os::FinalizeMultiWait(std::addressof(g_multi_wait));
+            };
+
+            /* Wait repeatedly without changing the holders. */
+            const auto wait_start = os::GetSystemTick().ToTimeSpan();
+            for (s32 i = 0; i < IterationCount; ++i) {
+                AMS_ABORT_UNLESS(os::TryWaitAny(std::addressof(g_multi_wait)) == std::addressof(g_holders[holder_count - 1]));
+            }
+            const auto wait_elapsed = os::GetSystemTick().ToTimeSpan() - wait_start;
+
+            /* Unlink and relink the signaled holder around every wait, as a server does with the session it processes. */
+            const auto relink_start = os::GetSystemTick().ToTimeSpan();
+            for (s32 i = 0; i < IterationCount; ++i) {
+                auto *holder = os::TryWaitAny(std::addressof(g_multi_wait));
+                os::UnlinkMultiWaitHolder(holder);
+                os::LinkMultiWaitHolder(std::addressof(g_multi_wait), holder);
+            }
+            const auto relink_elapsed = os::GetSystemTick().ToTimeSpan() - relink_start;
+
+            std::printf("MultiWait, %2d holders, %s: %.1f ns/wait, %.1f ns/wait+relink\n", holder_count, use_cache ? "cached  " : "uncached", static_cast<double>(wait_elapsed.GetNanoSeconds()) / IterationCount, static_cast<double>(relink_elapsed.GetNanoSeconds()) / IterationCount);
+        }
+
+    }
+
+    void BenchmarkMultiWait() {
+        for (const s32 holder_count : { 8, 32, 64 }) {
+            MeasureMultiWait(holder_count, false);
+            MeasureMultiWait(holder_count, true);
+        }
+    }
+
+}
+
+#endif
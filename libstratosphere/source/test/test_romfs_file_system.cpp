@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) Atmosphère-NX
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms and conditions of the GNU General Public License,
+ * version 2, as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <stratosphere.hpp>
+
+/* TODO: Define to enable tests? */
+#if 0
+#include <cstdio>
+
+namespace ams::test {
+
+    namespace {
+
+        using RomFileTable = fssystem::RomFsFileSystem::RomFileTable;
+
+        constexpr s32 OpenCount     = 100000;
+        constexpr size_t NameLength = 8;
+
+        constexpr size_t AlignTable(size_t size) {
+            return util::AlignUp(size, alignof(s64));
+        }
+
+        void MakeDirectoryPath(char *dst, size_t dst_size, s32 depth) {
+            /* Directories form a single chain, /d00/d01/.../dNN. */
+            size_t len = 0;
+            dst[0] = '\x00';
+            for (s32 i = 0; i < depth; ++i) {
+                len += util::SNPrintf(dst + len, dst_size - len, "/d%02d", i);
+            }
+        }
+
+        void MakeFilePath(char *dst, size_t dst_size, s32 index, s32 depth) {
+            /* Files are spread round-robin over every level of the chain, including the root. */
+            char dir[fs::EntryNameLengthMax + 1];
+            MakeDirectoryPath(dir, sizeof(dir), index % (depth + 1));
+            util::SNPrintf(dst, dst_size, "%s/f%06d", dir, index);
+        }
+
+        void *BuildImage(size_t *out_size, s32 file_count, s32 depth) {
+            /* Determine the layout of the image. */
+            const s64 dir_bucket_count  = depth + 1;
+            const s64 file_bucket_count = file_count / 2 + 1;
+
+            const size_t dir_bucket_size  = AlignTable(RomFileTable::QueryDirectoryEntryBucketStorageSize(dir_bucket_count));
+            const size_t dir_entry_size   = AlignTable(RomFileTable::QueryDirectoryEntrySize(NameLength) * (depth + 1));
+            const size_t file_bucket_size = AlignTable(RomFileTable::QueryFileEntryBucketStorageSize(file_bucket_count));
+            const size_t file_entry_size  = AlignTable(RomFileTable::QueryFileEntrySize(NameLength) * file_count);
+
+            fs::RomFileSystemInformation header = {};
+            header.directory_bucket_offset = sizeof(header);
+            header.directory_bucket_size   = dir_bucket_size;
+            header.directory_entry_offset  = header.directory_bucket_offset + dir_bucket_size;
+            header.directory_entry_size    = dir_entry_size;
+            header.file_bucket_offset      = header.directory_entry_offset + dir_entry_size;
+            header.file_bucket_size        = file_bucket_size;
+            header.file_entry_offset       = header.file_bucket_offset + file_bucket_size;
+            header.file_entry_size         = file_entry_size;
+            header.body_offset             = header.file_entry_offset + file_entry_size;
+            header.size                    = sizeof(header);
+
+            const size_t image_size = static_cast<size_t>(header.body_offset);
+            void *image = std::malloc(image_size);
+            AMS_ABORT_UNLESS(image != nullptr);
+            std::memset(image, 0, image_size);
+            std::memcpy(image, std::addressof(header), sizeof(header));
+
+            /* Create the tables in place. */
+            fs::MemoryStorage storage(image, image_size);
+            fs::SubStorage dir_bucket(std::addressof(storage),  header.directory_bucket_offset, header.directory_bucket_size);
+            fs::SubStorage dir_entry(std::addressof(storage),   header.directory_entry_offset,  header.directory_entry_size);
+            fs::SubStorage file_bucket(std::addressof(storage), header.file_bucket_offset,      header.file_bucket_size);
+            fs::SubStorage file_entry(std::addressof(storage),  header.file_entry_offset,       header.file_entry_size);
+
+            R_ABORT_UNLESS(RomFileTable::Format(dir_bucket, file_bucket));
+
+            RomFileTable table;
+            R_ABORT_UNLESS(table.Initialize(dir_bucket, dir_entry, file_bucket, file_entry));
+            R_ABORT_UNLESS(table.CreateRootDirectory());
+
+            char path[fs::EntryNameLengthMax + 1];
+            for (s32 i = 1; i <= depth; ++i) {
+                MakeDirectoryPath(path, sizeof(path), i);
+
+                fs::RomDirectoryId dir_id;
+                R_ABORT_UNLESS(table.CreateDirectory(std::addressof(dir_id), path, RomFileTable::DirectoryInfo{}));
+            }
+
+            for (s32 i = 0; i < file_count; ++i) {
+                MakeFilePath(path, sizeof(path), i, depth);
+
+                RomFileTable::FileInfo info = {};
+                info.offset = 0;
+                info.size   = 0;
+
+                fs::RomFileId file_id;
+                R_ABORT_UNLESS(table.CreateFile(std::addressof(file_id), path, info));
+            }
+
+            *out_size = image_size;
+            return image;
+        }
+
+        void MeasureOpen(s32 file_count, s32 depth, bool use_cache) {
+            size_t image_size;
+            void *image = BuildImage(std::addressof(image_size), file_count, depth);
+            ON_SCOPE_EXIT { std::free(image); };
+
+            fs::MemoryStorage storage(image, image_size);
+
+            /* Mount the image. Only a cached mount builds the path index. */
+            size_t work_size = 0;
+            R_ABORT_UNLESS(fssystem::RomFsFileSystem::GetRequiredWorkingMemorySize(std::addressof(work_size), std::addressof(storage)));
+
+            void *work = use_cache ? std::malloc(work_size) : nullptr;
+            AMS_ABORT_UNLESS(!use_cache || work != nullptr);
+            ON_SCOPE_EXIT { std::free(work); };
+
+            fssystem::RomFsFileSystem romfs;
+            const auto mount_start = os::GetSystemTick().ToTimeSpan();
+            R_ABORT_UNLESS(romfs.Initialize(std::addressof(storage), work, work_size, use_cache));
+            const auto mount_elapsed = os::GetSystemTick().ToTimeSpan() - mount_start;
+
+            /* Open files in a stride which visits every level of the directory chain. */
+            char path[fs::EntryNameLengthMax + 1];
+            const auto start = os::GetSystemTick().ToTimeSpan();
+            for (s32 i = 0; i < OpenCount; ++i) {
+                MakeFilePath(path, sizeof(path), (i * 7919) % file_count, depth);
+
+                std::unique_ptr<fs::fsa::IFile> file;
+                R_ABORT_UNLESS(romfs.OpenFile(std::addressof(file), path, fs::OpenMode_Read));
+            }
+            const auto elapsed = os::GetSystemTick().ToTimeSpan() - start;
+
+            std::printf("RomFsFileSystem, %5d files, depth %2d, %s: mount %.1f us, %.1f ns/open\n", file_count, depth, use_cache ? "cached (index)" : "uncached (table)", static_cast<double>(mount_elapsed.GetNanoSeconds()) / 1000, static_cast<double>(elapsed.GetNanoSeconds()) / OpenCount);
+        }
+
+    }
+
+    void BenchmarkRomFsFileSystem() {
+        /* NOTE: Times include formatting each path, which is the same for both modes. */
+        constexpr s32 FileCounts[] = { 64, 1024, 16384 };
+        constexpr s32 Depths[]     = { 0, 4, 16 };
+        for (const s32 file_count : FileCounts) {
+            for (const s32 depth : Depths) {
+                MeasureOpen(file_count, depth, false);
+                MeasureOpen(file_count, depth, true);
+            }
+        }
+    }
+
+}
+
+#endif
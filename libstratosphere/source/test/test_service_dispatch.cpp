@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) Atmosphère-NX
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms and conditions of the GNU General Public License,
+ * version 2, as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <stratosphere.hpp>
+
+/* TODO: Define to enable tests? */
+#if 0
+#include <cstdio>
+
+namespace ams::test {
+
+    namespace {
+
+        constexpr s32 DispatchCount = 1000000;
+        constexpr s32 HeaderCount   = 256;
+
+        constinit CmifOutHeader g_out_header = {};
+
+        Result DummyCommandHandler(CmifOutHeader **out_header_ptr, sf::cmif::ServiceDispatchContext &ctx, const sf::cmif::PointerAndSize &in_raw_data) {
+            AMS_UNUSED(ctx, in_raw_data);
+            *out_header_ptr = std::addressof(g_out_header);
+            return ResultSuccess();
+        }
+
+        template<size_t N>
+        constexpr std::array<sf::cmif::ServiceCommandMeta, N> MakeCommandEntries() {
+            /* Declare commands out of id order, with gaps, as real interfaces do. */
+            std::array<sf::cmif::ServiceCommandMeta, N> entries{};
+            for (size_t i = 0; i < N; ++i) {
+                entries[i] = sf::cmif::ServiceCommandMeta{ hos::Version_Min, hos::Version_Max, static_cast<u32>(((i * 37) % N) * 10), DummyCommandHandler };
+            }
+            return entries;
+        }
+
+        /* The per-request linear scan which the sorted index replaced, for comparison. */
+        template<size_t N>
+        Result ProcessMessageByLinearScan(const std::array<sf::cmif::ServiceCommandMeta, N> &entries, sf::cmif::ServiceDispatchContext &ctx, const sf::cmif::PointerAndSize &in_raw_data) {
+            const auto hos_version = hos::GetVersion();
+            const CmifInHeader *in_header = reinterpret_cast<const CmifInHeader *>(in_raw_data.GetPointer());
+
+            decltype(sf::cmif::ServiceCommandMeta::handler) cmd_handler = nullptr;
+            for (size_t i = 0; i < N; i++) {
+                if (entries[i].Matches(in_header->command_id, hos_version)) {
+                    cmd_handler = entries[i].GetHandler();
+                    break;
+                }
+            }
+            R_UNLESS(cmd_handler != nullptr, sf::cmif::ResultUnknownCommandId());
+
+            CmifOutHeader *out_header = nullptr;
+            return cmd_handler(std::addressof(out_header), ctx, sf::cmif::PointerAndSize(in_raw_data.GetAddress() + sizeof(*in_header), in_raw_data.GetSize() - sizeof(*in_header)));
+        }
+
+        CmifInHeader g_in_headers[HeaderCount];
+
+        template<size_t N>
+        void MeasureDispatch() {
+            static constexpr auto Entries = MakeCommandEntries<N>();
+            static constexpr sf::cmif::ServiceDispatchTable<N> Table(Entries);
+
+            /* Make synthetic request headers for valid command ids, in a scattered order. */
+            u32 seed = 0x12345678;
+            for (s32 i = 0; i < HeaderCount; ++i) {
+                seed = seed * 1103515245 + 12345;
+                g_in_headers[i] = CmifInHeader{ CMIF_IN_HEADER_MAGIC, 0, Entries[(seed >> 16) % N].cmd_id, 0 };
+            }
+
+            sf::cmif::ServiceDispatchContext ctx = { nullptr, nullptr, nullptr, nullptr, nullptr, {}, {}, {}, {} };
+
+            /* Dispatch through the sorted index. */
+            const auto start = os::GetSystemTick().ToTimeSpan();
+            for (s32 i = 0; i < DispatchCount; ++i) {
+                R_ABORT_UNLESS(Table.ProcessMessage(ctx, sf::cmif::PointerAndSize(std::addressof(g_in_headers[i % HeaderCount]), sizeof(CmifInHeader))));
+            }
+            const auto sorted_elapsed = os::GetSystemTick().ToTimeSpan() - start;
+
+            /* Dispatch by linear scan. */
+            const auto linear_start = os::GetSystemTick().ToTimeSpan();
+            for (s32 i = 0; i < DispatchCount; ++i) {
+                R_ABORT_UNLESS(ProcessMessageByLinearScan(Entries, ctx, sf::cmif::PointerAndSize(std::addressof(g_in_headers[i % HeaderCount]), sizeof(CmifInHeader))));
+            }
+            const auto linear_elapsed = os::GetSystemTick().ToTimeSpan() - linear_start;
+
+            std::printf("ServiceDispatchTable, %3zu commands: %.1f ns/dispatch sorted, %.1f ns/dispatch linear\n", N, static_cast<double>(sorted_elapsed.GetNanoSeconds()) / DispatchCount, static_cast<double>(linear_elapsed.GetNanoSeconds()) / DispatchCount);
+        }
+
+    }
+
+    void BenchmarkServiceDispatch() {
+        MeasureDispatch<8>();
+        MeasureDispatch<32>();
+        MeasureDispatch<128>();
+        MeasureDispatch<256>();
+    }
+
+}
+
+#endif
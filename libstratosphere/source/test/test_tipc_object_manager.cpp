@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) Atmosphère-NX
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms and conditions of the GNU General Public License,
+ * version 2, as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <stratosphere.hpp>
+
+/* TODO: Define to enable tests? */
+#if 0
+#include <cstdio>
+
+namespace ams::test {
+
+    namespace {
+
+        constexpr s32 MessageCount = 100000;
+        constexpr u16 EchoMethodId = 16;
+
+        constexpr size_t ServerThreadStackSize = 16_KB;
+        alignas(os::ThreadStackAlignment) u8 g_server_thread_stack[ServerThreadStackSize];
+
+        class EchoObject : public tipc::ServiceObjectBase {
+            public:
+                virtual Result ProcessRequest() override {
+                    /* Reply with an empty successful response. */
+                    const svc::ipc::MessageBuffer message_buffer(svc::ipc::GetMessageBuffer());
+                    const auto index = message_buffer.Set(svc::ipc::MessageBuffer::MessageHeader(0, false, 0, 0, 0, 0, 1, 0));
+                    message_buffer.SetRaw(index, ResultSuccess().GetValue());
+                    return ResultSuccess();
+                }
+        };
+
+        EchoObject g_echo_object;
+
+        struct ServerArgument {
+            tipc::ObjectManagerBase *object_manager;
+            os::MultiWaitType *multi_wait;
+            os::MultiWaitHolderType *stop_holder;
+        };
+
+        void ServerThreadFunction(void *arg) {
+            const auto &server = *static_cast<const ServerArgument *>(arg);
+
+            /* Serve requests as the tipc server manager does, until we're told to stop. */
+            os::NativeHandle reply_target = os::InvalidNativeHandle;
+            while (true) {
+                if (reply_target == os::InvalidNativeHandle) {
+                    svc::ipc::MessageBuffer(svc::ipc::GetMessageBuffer()).SetNull();
+                }
+
+                os::MultiWaitHolderType *signaled_holder = nullptr;
+                tipc::ObjectHolder signaled_object{};
+                if (R_FAILED(server.object_manager->ReplyAndReceive(std::addressof(signaled_holder), std::addressof(signaled_object), reply_target, server.multi_wait))) {
+                    reply_target = os::InvalidNativeHandle;
+                    continue;
+                }
+
+                if (signaled_holder == server.stop_holder) {
+                    break;
+                }
+
+                R_ABORT_UNLESS(server.object_manager->ProcessRequest(signaled_object));
+                reply_target = signaled_object.GetHandle();
+            }
+        }
+
+        template<s32 SessionCount>
+        void MeasureMessages() {
+            static tipc::ObjectManager<SessionCount> s_object_manager;
+            static os::MultiWaitType s_multi_wait;
+            static os::Event s_stop_event(os::EventClearMode_ManualClear);
+            static os::MultiWaitHolderType s_stop_holder;
+            static svc::Handle s_client_handles[SessionCount];
+            static svc::Handle s_server_handles[SessionCount];
+
+            /* Set up the object manager, with one session object per session. */
+            os::InitializeMultiWait(std::addressof(s_multi_wait));
+            s_object_manager.Initialize(std::addressof(s_multi_wait));
+
+            for (s32 i = 0; i < SessionCount; ++i) {
+                R_ABORT_UNLESS(svc::CreateSession(std::addressof(s_server_handles[i]), std::addressof(s_client_handles[i]), false, 0));
+
+                tipc::ObjectHolder object;
+                object.InitializeAsSession(s_server_handles[i], false, std::addressof(g_echo_object));
+                s_object_manager.AddObject(object);
+            }
+
+            s_stop_event.Clear();
+            os::InitializeMultiWaitHolder(std::addressof(s_stop_holder), s_stop_event.GetBase());
+            os::LinkMultiWaitHolder(std::addressof(s_multi_wait), std::addressof(s_stop_holder));
+
+            /* Start the server. */
+            ServerArgument server = { std::addressof(s_object_manager), std::addressof(s_multi_wait), std::addressof(s_stop_holder) };
+
+            os::ThreadType server_thread;
+            R_ABORT_UNLESS(os::CreateThread(std::addressof(server_thread), ServerThreadFunction, std::addressof(server), g_server_thread_stack, sizeof(g_server_thread_stack), os::GetThreadPriority(os::GetCurrentThread())));
+            os::StartThread(std::addressof(server_thread));
+
+            /* Send requests round-robin over every session. */
+            const auto start = os::GetSystemTick().ToTimeSpan();
+            for (s32 i = 0; i < MessageCount; ++i) {
+                svc::ipc::MessageBuffer(svc::ipc::GetMessageBuffer()).Set(svc::ipc::MessageBuffer::MessageHeader(EchoMethodId, false, 0, 0, 0, 0, 0, 0));
+                R_ABORT_UNLESS(svc::SendSyncRequest(s_client_handles[i % SessionCount]));
+            }
+            const auto elapsed = os::GetSystemTick().ToTimeSpan() - start;
+
+            /* Stop the server. */
+            s_stop_event.Signal();
+            os::WaitThread(std::addressof(server_thread));
+            os::DestroyThread(std::addressof(server_thread));
+
+            /* Clean up. */
+            os::UnlinkMultiWaitHolder(std::addressof(s_stop_holder));
+            os::FinalizeMultiWaitHolder(std::addressof(s_stop_holder));
+
+            for (s32 i = 0; i < SessionCount; ++i) {
+                s_object_manager.CloseObject(s_server_handles[i]);
+                R_ABORT_UNLESS(svc::CloseHandle(s_server_handles[i]));
+                R_ABORT_UNLESS(svc::CloseHandle(s_client_handles[i]));
+            }
+
+            os::FinalizeMultiWait(std::addressof(s_multi_wait));
+
+            std::printf("tipc::ObjectManager, %3d sessions: %.0f messages/s\n", SessionCount, static_cast<double>(MessageCount) * TimeSpan::FromSeconds(1).GetNanoSeconds() / elapsed.GetNanoSeconds());
+        }
+
+    }
+
+    void BenchmarkTipcObjectManager() {
+        MeasureMessages<64>();
+        MeasureMessages<256>();
+    }
+
+}
+
+#endif
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) Atmosphère-NX
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms and conditions of the GNU General Public License,
+ * version 2, as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <stratosphere.hpp>
+
+/* TODO: Define to enable tests? */
+#if 0
+#include <cstdio>
+
+namespace ams::test {
+
+    namespace {
+
+        constexpr size_t StorageSize = 4_MB;
+        constexpr size_t ReadSize    = 1_MB;
+        constexpr size_t DataAlign   = 0x200;
+
+        constexpr u8 Key[fssystem::AesCtrCounterExtendedStorage::KeySize] = { 0x2B, 0x7E, 0x15, 0x16, 0x28, 0xAE, 0xD2, 0xA6, 0xAB, 0xF7, 0x15, 0x88, 0x09, 0xCF, 0x4F, 0x3C };
+
+        alignas(os::MemoryPageSize) u8 g_storage_buffer[StorageSize];
+        alignas(os::MemoryPageSize) u8 g_read_buffer[ReadSize + os::MemoryPageSize];
+
+        constinit size_t g_decrypt_copy_size = 0;
+
+        /* Counts the bytes that a read delivers somewhere other than the caller's buffer, and which must therefore be copied. */
+        class CopyCountingStorage : public fs::IStorage, public fs::impl::Newable {
+            private:
+                fs::MemoryStorage m_base_storage;
+                const u8 *m_caller_buffer;
+                size_t m_caller_size;
+                size_t m_copy_size;
+            public:
+                CopyCountingStorage(void *buffer, size_t size) : m_base_storage(buffer, size), m_caller_buffer(nullptr), m_caller_size(0), m_copy_size(0) { /* ... */ }
+
+                void SetCallerBuffer(const void *buffer, size_t size) {
+                    m_caller_buffer = static_cast<const u8 *>(buffer);
+                    m_caller_size   = size;
+                    m_copy_size     = 0;
+                }
+
+                size_t GetCopySize() const { return m_copy_size; }
+
+                virtual Result Read(s64 offset, void *buffer, size_t size) override {
+                    const u8 *dst = static_cast<const u8 *>(buffer);
+                    if (!(m_caller_buffer <= dst && dst + size <= m_caller_buffer + m_caller_size)) {
+                        m_copy_size += size;
+                    }
+                    return m_base_storage.Read(offset, buffer, size);
+                }
+
+                virtual Result Write(s64 offset, const void *buffer, size_t size) override { return m_base_storage.Write(offset, buffer, size); }
+                virtual Result Flush() override { return m_base_storage.Flush(); }
+                virtual Result SetSize(s64 size) override { return m_base_storage.SetSize(size); }
+                virtual Result GetSize(s64 *out) override { return m_base_storage.GetSize(out); }
+                virtual Result OperateRange(void *dst, size_t dst_size, fs::OperationId op_id, s64 offset, s64 size, const void *src, size_t src_size) override { return m_base_storage.OperateRange(dst, dst_size, op_id, offset, size, src, src_size); }
+        };
+
+        /* Stands in for spl::ComputeCtr, counting the bytes decrypted out of place, which the decryptor then copies back. */
+        void CountingDecryptFunction(void *dst, size_t dst_size, s32 index, const void *enc_key, size_t enc_key_size, const void *iv, size_t iv_size, const void *src, size_t src_size) {
+            AMS_UNUSED(index, enc_key, enc_key_size);
+            if (dst != src) {
+                g_decrypt_copy_size += dst_size;
+            }
+            crypto::DecryptAes128Ctr(dst, dst_size, Key, sizeof(Key), iv, iv_size, src, src_size);
+        }
+
+        void PrintCopySize(const char *name, size_t copy_size, size_t read_size) {
+            std::printf("%-48s %10zu bytes copied per MB read\n", name, static_cast<size_t>(static_cast<double>(copy_size) * 1_MB / read_size));
+        }
+
+        void MeasureAlignmentMatching(const char *name, s64 offset, void *buffer) {
+            CopyCountingStorage base_storage(g_storage_buffer, StorageSize);
+            fssystem::AlignmentMatchingStoragePooledBuffer<1> storage(std::addressof(base_storage), DataAlign);
+
+            base_storage.SetCallerBuffer(buffer, ReadSize);
+            R_ABORT_UNLESS(storage.Read(offset, buffer, ReadSize));
+
+            PrintCopySize(name, base_storage.GetCopySize(), ReadSize);
+        }
+
+        void MeasureExternalDecryptor(const char *name, void *buffer) {
+            std::unique_ptr<fssystem::AesCtrCounterExtendedStorage::IDecryptor> decryptor;
+            R_ABORT_UNLESS(fssystem::AesCtrCounterExtendedStorage::CreateExternalDecryptor(std::addressof(decryptor), CountingDecryptFunction, 0));
+
+            u8 ctr[fssystem::AesCtrCounterExtendedStorage::IvSize] = {};
+            g_decrypt_copy_size = 0;
+            decryptor->Decrypt(buffer, ReadSize, Key, sizeof(Key), ctr, sizeof(ctr));
+
+            PrintCopySize(name, g_decrypt_copy_size, ReadSize);
+        }
+
+    }
+
+    void BenchmarkZeroCopyRead() {
+        /* NOTE: Only one additional device address range can be registered, so this must not run while another is. */
+        void * const buffer = g_read_buffer;
+
+        /* Reads into ordinary memory, which the storages can't hand to the device. */
+        MeasureAlignmentMatching("AlignmentMatchingStoragePooledBuffer, aligned", 0, buffer);
+        MeasureAlignmentMatching("AlignmentMatchingStoragePooledBuffer, unaligned", 0x10, buffer);
+        MeasureExternalDecryptor("ExternalDecryptor, ordinary buffer", buffer);
+
+        /* Reads into a registered device address range. */
+        fssystem::RegisterAdditionalDeviceAddress(reinterpret_cast<uintptr_t>(g_read_buffer), sizeof(g_read_buffer));
+        ON_SCOPE_EXIT { fssystem::UnregisterAdditionalDeviceAddress(reinterpret_cast<uintptr_t>(g_read_buffer)); };
+
+        MeasureExternalDecryptor("ExternalDecryptor, device address buffer", buffer);
+    }
+
+}
+
+#endif
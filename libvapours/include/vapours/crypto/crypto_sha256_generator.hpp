@@ -81,4 +81,8 @@ namespace ams::crypto {
 
     void GenerateSha256Hash(void *dst, size_t dst_size, const void *src, size_t src_size);
 
+    /* Hashes src_count independent buffers of src_size bytes each, in lockstep where the platform allows. */
+    /* The hash of srcs[i] is written to dst + i * HashSize. */
+    void GenerateSha256HashMulti(void *dst, size_t dst_size, const void * const *srcs, size_t src_count, size_t src_size);
+
 }
@@ -69,4 +69,7 @@ namespace ams::crypto::impl {
 
     static_assert(HashFunction<Sha256Impl>);
 
+    /* Hashes count equally-sized, independent buffers, writing count consecutive hashes to dst. */
+    void GenerateSha256HashMulti(void *dst, const void * const *srcs, size_t count, size_t src_size);
+
 }
@@ -25,4 +25,12 @@ namespace ams::crypto {
         gen.GetHash(dst, dst_size);
     }
 
+    void GenerateSha256HashMulti(void *dst, size_t dst_size, const void * const *srcs, size_t src_count, size_t src_size) {
+        AMS_ASSERT(dst_size >= src_count * Sha256Generator::HashSize);
+        AMS_ASSERT(srcs != nullptr || src_count == 0);
+        AMS_UNUSED(dst_size);
+
+        impl::GenerateSha256HashMulti(dst, srcs, src_count, src_size);
+    }
+
 }
@@ -84,6 +84,58 @@ namespace ams::crypto::impl {
             return inc;
         }
 
+        template<s32 RoundCount>
+        void ProcessEightBlocks(u8 *&dst, const u8 *&src, size_t &num_blocks, uint8x16_t &ctr0, const u8 *keys) {
+            /* If we don't have enough blocks, there's nothing to do. */
+            if (num_blocks < 8) {
+                return;
+            }
+
+            /* Load the round keys. */
+            uint8x16_t round_keys[RoundCount + 1];
+            for (s32 i = 0; i <= RoundCount; ++i) {
+                round_keys[i] = vld1q_u8(keys + AES_BLOCK_SIZE * i);
+            }
+
+            /* Track the counter as native integers, so that producing eight counters doesn't serialize on the vector unit. */
+            u64 high = util::SwapBytes(vgetq_lane_u64(vreinterpretq_u64_u8(ctr0), 0));
+            u64 low  = util::SwapBytes(vgetq_lane_u64(vreinterpretq_u64_u8(ctr0), 1));
+
+            auto get_and_increment = [&]() ALWAYS_INLINE_LAMBDA -> uint8x16_t {
+                const uint8x16_t block = vreinterpretq_u8_u64(vcombine_u64(vcreate_u64(util::SwapBytes(high)), vcreate_u64(util::SwapBytes(low))));
+                if ((++low) == 0) {
+                    ++high;
+                }
+                return block;
+            };
+
+            /* Eight independent blocks per iteration keep the AES pipeline full on cores with deep aese/aesmc latency. */
+            while (num_blocks >= 8) {
+                uint8x16_t tmp[8];
+                for (size_t i = 0; i < 8; ++i) {
+                    tmp[i] = get_and_increment();
+                }
+
+                for (s32 r = 0; r < RoundCount - 1; ++r) {
+                    for (size_t i = 0; i < 8; ++i) {
+                        tmp[i] = vaesmcq_u8(vaeseq_u8(tmp[i], round_keys[r]));
+                    }
+                }
+
+                for (size_t i = 0; i < 8; ++i) {
+                    tmp[i] = veorq_u8(vaeseq_u8(tmp[i], round_keys[RoundCount - 1]), round_keys[RoundCount]);
+                    vst1q_u8(dst, veorq_u8(vld1q_u8(src), tmp[i]));
+                    src += AES_BLOCK_SIZE;
+                    dst += AES_BLOCK_SIZE;
+                }
+
+                num_blocks -= 8;
+            }
+
+            /* Write back the counter, so the three/one block paths can continue from it. */
+            ctr0 = get_and_increment();
+        }
+
     }
 
     template<>
@@ -104,6 +156,9 @@ namespace ams::crypto::impl {
         uint8x16_t ctr0 = vld1q_u8(m_counter);
         uint64_t high, low;
 
+        /* Process eight blocks at a time, when possible. */
+        ProcessEightBlocks<10>(dst, src, num_blocks, ctr0, keys);
+
         /* Process three blocks at a time, when possible. */
         if (num_blocks >= 3) {
             /* Increment CTR twice. */
@@ -260,6 +315,9 @@ namespace ams::crypto::impl {
         uint8x16_t ctr0 = vld1q_u8(m_counter);
         uint64_t high, low;
 
+        /* Process eight blocks at a time, when possible. */
+        ProcessEightBlocks<12>(dst, src, num_blocks, ctr0, keys);
+
         /* Process three blocks at a time, when possible. */
         if (num_blocks >= 3) {
             /* Increment CTR twice. */
@@ -426,6 +484,9 @@ namespace ams::crypto::impl {
         uint8x16_t ctr0 = vld1q_u8(m_counter);
         uint64_t high, low;
 
+        /* Process eight blocks at a time, when possible. */
+        ProcessEightBlocks<14>(dst, src, num_blocks, ctr0, keys);
+
         /* Process three blocks at a time, when possible. */
         if (num_blocks >= 3) {
             /* Increment CTR twice. */
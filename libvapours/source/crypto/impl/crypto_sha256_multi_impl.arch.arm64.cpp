@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) Atmosphère-NX
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms and conditions of the GNU General Public License,
+ * version 2, as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <vapours.hpp>
+
+#ifdef ATMOSPHERE_IS_STRATOSPHERE
+#include <arm_neon.h>
+
+namespace ams::crypto::impl {
+
+    namespace {
+
+        constexpr size_t HashSize  = Sha256Impl::HashSize;
+        constexpr size_t BlockSize = Sha256Impl::BlockSize;
+
+        alignas(16) constexpr const u32 RoundConstants[64] = {
+            0x428A2F98, 0x71374491, 0xB5C0FBCF, 0xE9B5DBA5, 0x3956C25B, 0x59F111F1, 0x923F82A4, 0xAB1C5ED5,
+            0xD807AA98, 0x12835B01, 0x243185BE, 0x550C7DC3, 0x72BE5D74, 0x80DEB1FE, 0x9BDC06A7, 0xC19BF174,
+            0xE49B69C1, 0xEFBE4786, 0x0FC19DC6, 0x240CA1CC, 0x2DE92C6F, 0x4A7484AA, 0x5CB0A9DC, 0x76F988DA,
+            0x983E5152, 0xA831C66D, 0xB00327C8, 0xBF597FC7, 0xC6E00BF3, 0xD5A79147, 0x06CA6351, 0x14292967,
+            0x27B70A85, 0x2E1B2138, 0x4D2C6DFC, 0x53380D13, 0x650A7354, 0x766A0ABB, 0x81C2C92E, 0x92722C85,
+            0xA2BFE8A1, 0xA81A664B, 0xC24B8B70, 0xC76C51A3, 0xD192E819, 0xD6990624, 0xF40E3585, 0x106AA070,
+            0x19A4C116, 0x1E376C08, 0x2748774C, 0x34B0BCB5, 0x391C0CB3, 0x4ED8AA4A, 0x5B9CCA4F, 0x682E6FF3,
+            0x748F82EE, 0x78A5636F, 0x84C87814, 0x8CC70208, 0x90BEFFFA, 0xA4506CEB, 0xBEF9A3F7, 0xC67178F2,
+        };
+
+        alignas(16) constexpr const u32 InitialHash[8] = {
+            0x6A09E667, 0xBB67AE85, 0x3C6EF372, 0xA54FF53A, 0x510E527F, 0x9B05688C, 0x1F83D9AB, 0x5BE0CD19,
+        };
+
+        struct State {
+            uint32x4_t abcd;
+            uint32x4_t efgh;
+        };
+
+        ALWAYS_INLINE State GetInitialState() {
+            return State{ vld1q_u32(InitialHash + 0), vld1q_u32(InitialHash + 4) };
+        }
+
+        ALWAYS_INLINE uint32x4_t LoadMessage(const u8 *src) {
+            return vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(src)));
+        }
+
+        ALWAYS_INLINE void StoreHash(u8 *dst, const State &state) {
+            vst1q_u8(dst + 0x00, vrev32q_u8(vreinterpretq_u8_u32(state.abcd)));
+            vst1q_u8(dst + 0x10, vrev32q_u8(vreinterpretq_u8_u32(state.efgh)));
+        }
+
+        ALWAYS_INLINE void ProcessQuadRound(State &state, uint32x4_t wk) {
+            const uint32x4_t abcd = state.abcd;
+            state.abcd = vsha256hq_u32(state.abcd, state.efgh, wk);
+            state.efgh = vsha256h2q_u32(state.efgh, abcd, wk);
+        }
+
+        /* Performs four rounds on both lanes, then extends the message schedule of each lane by four words. */
+        #define SHA256_TWO_WAY_QUAD_ROUND(i, w0, w1, w2, w3)                                          \
+        {                                                                                             \
+            const uint32x4_t k = vld1q_u32(RoundConstants + 4 * (i));                                 \
+            ProcessQuadRound(state0, vaddq_u32(msg0_##w0, k));                                        \
+            ProcessQuadRound(state1, vaddq_u32(msg1_##w0, k));                                        \
+            if ((i) < 12) {                                                                           \
+                msg0_##w0 = vsha256su1q_u32(vsha256su0q_u32(msg0_##w0, msg0_##w1), msg0_##w2, msg0_##w3); \
+                msg1_##w0 = vsha256su1q_u32(vsha256su0q_u32(msg1_##w0, msg1_##w1), msg1_##w2, msg1_##w3); \
+            }                                                                                         \
+        }
+
+        void ProcessBlocksTwoWay(State &state0, State &state1, const u8 *src0, const u8 *src1, size_t num_blocks) {
+            /* The SHA-2 instructions have several cycles of latency, and every round depends on the last. */
+            /* Running two independent messages side by side lets one lane issue while the other waits. */
+            while (num_blocks > 0) {
+                const State prev0 = state0;
+                const State prev1 = state1;
+
+                uint32x4_t msg0_0 = LoadMessage(src0 + 0x00);
+                uint32x4_t msg0_1 = LoadMessage(src0 + 0x10);
+                uint32x4_t msg0_2 = LoadMessage(src0 + 0x20);
+                uint32x4_t msg0_3 = LoadMessage(src0 + 0x30);
+                uint32x4_t msg1_0 = LoadMessage(src1 + 0x00);
+                uint32x4_t msg1_1 = LoadMessage(src1 + 0x10);
+                uint32x4_t msg1_2 = LoadMessage(src1 + 0x20);
+                uint32x4_t msg1_3 = LoadMessage(src1 + 0x30);
+
+                SHA256_TWO_WAY_QUAD_ROUND( 0, 0, 1, 2, 3);
+                SHA256_TWO_WAY_QUAD_ROUND( 1, 1, 2, 3, 0);
+                SHA256_TWO_WAY_QUAD_ROUND( 2, 2, 3, 0, 1);
+                SHA256_TWO_WAY_QUAD_ROUND( 3, 3, 0, 1, 2);
+                SHA256_TWO_WAY_QUAD_ROUND( 4, 0, 1, 2, 3);
+                SHA256_TWO_WAY_QUAD_ROUND( 5, 1, 2, 3, 0);
+                SHA256_TWO_WAY_QUAD_ROUND( 6, 2, 3, 0, 1);
+                SHA256_TWO_WAY_QUAD_ROUND( 7, 3, 0, 1, 2);
+                SHA256_TWO_WAY_QUAD_ROUND( 8, 0, 1, 2, 3);
+                SHA256_TWO_WAY_QUAD_ROUND( 9, 1, 2, 3, 0);
+                SHA256_TWO_WAY_QUAD_ROUND(10, 2, 3, 0, 1);
+                SHA256_TWO_WAY_QUAD_ROUND(11, 3, 0, 1, 2);
+                SHA256_TWO_WAY_QUAD_ROUND(12, 0, 1, 2, 3);
+                SHA256_TWO_WAY_QUAD_ROUND(13, 1, 2, 3, 0);
+                SHA256_TWO_WAY_QUAD_ROUND(14, 2, 3, 0, 1);
+                SHA256_TWO_WAY_QUAD_ROUND(15, 3, 0, 1, 2);
+
+                state0.abcd = vaddq_u32(state0.abcd, prev0.abcd);
+                state0.efgh = vaddq_u32(state0.efgh, prev0.efgh);
+                state1.abcd = vaddq_u32(state1.abcd, prev1.abcd);
+                state1.efgh = vaddq_u32(state1.efgh, prev1.efgh);
+
+                src0 += BlockSize;
+                src1 += BlockSize;
+                --num_blocks;
+            }
+        }
+
+        #undef SHA256_TWO_WAY_QUAD_ROUND
+
+        void GenerateSha256HashTwoWay(u8 *dst0, u8 *dst1, const u8 *src0, const u8 *src1, size_t src_size) {
+            State state0 = GetInitialState();
+            State state1 = GetInitialState();
+
+            /* Process all full blocks. */
+            const size_t num_blocks = src_size / BlockSize;
+            ProcessBlocksTwoWay(state0, state1, src0, src1, num_blocks);
+
+            /* Both messages have the same length, so they share the same padding layout. */
+            const size_t tail_size  = src_size % BlockSize;
+            const size_t pad_blocks = (tail_size + 1 + sizeof(u64) <= BlockSize) ? 1 : 2;
+
+            u8 last0[2 * BlockSize] = {};
+            u8 last1[2 * BlockSize] = {};
+            std::memcpy(last0, src0 + num_blocks * BlockSize, tail_size);
+            std::memcpy(last1, src1 + num_blocks * BlockSize, tail_size);
+            last0[tail_size] = 0x80;
+            last1[tail_size] = 0x80;
+
+            const u64 bits_consumed = util::ConvertToBigEndian<u64>(static_cast<u64>(src_size) * BITSIZEOF(u8));
+            std::memcpy(last0 + pad_blocks * BlockSize - sizeof(u64), std::addressof(bits_consumed), sizeof(bits_consumed));
+            std::memcpy(last1 + pad_blocks * BlockSize - sizeof(u64), std::addressof(bits_consumed), sizeof(bits_consumed));
+
+            ProcessBlocksTwoWay(state0, state1, last0, last1, pad_blocks);
+
+            StoreHash(dst0, state0);
+            StoreHash(dst1, state1);
+
+            /* Don't leave message data behind on the stack. */
+            ClearMemory(last0, sizeof(last0));
+            ClearMemory(last1, sizeof(last1));
+        }
+
+    }
+
+    void GenerateSha256HashMulti(void *dst, const void * const *srcs, size_t count, size_t src_size) {
+        u8 *cur_dst = static_cast<u8 *>(dst);
+
+        /* Hash the buffers in pairs. */
+        size_t i = 0;
+        for (/* ... */; i + 2 <= count; i += 2) {
+            GenerateSha256HashTwoWay(cur_dst, cur_dst + HashSize, static_cast<const u8 *>(srcs[i]), static_cast<const u8 *>(srcs[i + 1]), src_size);
+            cur_dst += 2 * HashSize;
+        }
+
+        /* Hash any unpaired buffer on its own. */
+        if (i < count) {
+            Sha256Impl sha;
+            sha.Initialize();
+            sha.Update(srcs[i], src_size);
+            sha.GetHash(cur_dst, HashSize);
+        }
+    }
+
+}
+
+#else
+
+/* TODO: Non-EL0 implementation. */
+namespace ams::crypto::impl {
+
+}
+
+#endif
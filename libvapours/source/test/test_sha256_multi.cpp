@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) Atmosphère-NX
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms and conditions of the GNU General Public License,
+ * version 2, as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <vapours.hpp>
+
+/* TODO: Define to enable tests? */
+#if 0
+#include <cstdio>
+#include <chrono>
+
+namespace ams::test {
+
+    namespace {
+
+        constexpr size_t BufferCount = 16;
+        constexpr size_t BufferSizeMax = 16_KB;
+
+        constexpr size_t HashSize = crypto::Sha256Generator::HashSize;
+
+        u8 g_buffers[BufferCount][BufferSizeMax];
+
+        void InitializeBuffers(const void **out_ptrs) {
+            u32 seed = 0x12345678;
+            for (size_t i = 0; i < BufferCount; ++i) {
+                for (size_t j = 0; j < BufferSizeMax; ++j) {
+                    seed = seed * 1103515245 + 12345;
+                    g_buffers[i][j] = static_cast<u8>(seed >> 16);
+                }
+                out_ptrs[i] = g_buffers[i];
+            }
+        }
+
+    }
+
+    bool TestSha256Multi() {
+        const void *ptrs[BufferCount];
+        InitializeBuffers(ptrs);
+
+        /* Check that every length and buffer count agrees with hashing one buffer at a time. */
+        constexpr size_t Sizes[] = { 0, 1, 55, 56, 63, 64, 65, 119, 120, 4_KB, 16_KB };
+        for (size_t size : Sizes) {
+            for (size_t count = 1; count <= BufferCount; ++count) {
+                u8 hashes[BufferCount][HashSize];
+                crypto::GenerateSha256HashMulti(hashes, sizeof(hashes), ptrs, count, size);
+
+                for (size_t i = 0; i < count; ++i) {
+                    u8 hash[HashSize];
+                    crypto::GenerateSha256Hash(hash, sizeof(hash), ptrs[i], size);
+
+                    if (std::memcmp(hash, hashes[i], HashSize) != 0) {
+                        return false;
+                    }
+                }
+            }
+        }
+
+        return true;
+    }
+
+    void BenchmarkSha256Multi() {
+        using Clock = std::chrono::steady_clock;
+        constexpr auto Duration = std::chrono::seconds(1);
+
+        const void *ptrs[BufferCount];
+        InitializeBuffers(ptrs);
+
+        constexpr size_t Sizes[] = { 4_KB, 16_KB };
+        for (size_t size : Sizes) {
+            u8 hashes[BufferCount][HashSize];
+
+            /* Measure hashing each buffer in turn. */
+            size_t single_count = 0;
+            for (const auto start = Clock::now(); Clock::now() - start < Duration; single_count += BufferCount) {
+                for (size_t i = 0; i < BufferCount; ++i) {
+                    crypto::GenerateSha256Hash(hashes[i], HashSize, ptrs[i], size);
+                }
+            }
+
+            /* Measure hashing all buffers at once. */
+            size_t multi_count = 0;
+            for (const auto start = Clock::now(); Clock::now() - start < Duration; multi_count += BufferCount) {
+                crypto::GenerateSha256HashMulti(hashes, sizeof(hashes), ptrs, BufferCount, size);
+            }
+
+            std::printf("SHA-256 %zu KiB blocks: single %zu hashes/s, multi %zu hashes/s\n", size / 1_KB, single_count, multi_count);
+        }
+    }
+
+}
+
+#endif